@@ -0,0 +1,281 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include <random>
+#include <sstl/bitmap_allocator.h>
+#include <sstl/freelist_allocator.h>
+#include "benchmark.h"
+#include "value_types.h"
+
+namespace sstl_bench
+{
+// internal linkage: the benchmark suites reuse the same helper names
+namespace
+{
+
+static const size_t CAPACITY = 4096;
+static const size_t TRACE_REPETITIONS = 10;
+static const size_t OCCUPANCY_BINS = 10;
+
+struct trace_operation
+{
+   bool is_allocation;
+   size_t slot; // identifies the allocated block, i.e. each allocation has its own slot
+};
+
+struct trace
+{
+   const char* name;
+   std::vector<trace_operation> operations;
+   size_t number_of_slots;
+};
+
+class trace_builder
+{
+public:
+   explicit trace_builder(const char* name) : _trace{ name, {}, 0 } {}
+
+   size_t allocate()
+   {
+      auto slot = _trace.number_of_slots++;
+      _trace.operations.push_back(trace_operation{ true, slot });
+      _live.push_back(slot);
+      return slot;
+   }
+
+   void deallocate_live(size_t live_idx)
+   {
+      _trace.operations.push_back(trace_operation{ false, _live[live_idx] });
+      _live[live_idx] = _live.back();
+      _live.pop_back();
+   }
+
+   size_t live() const
+   {
+      return _live.size();
+   }
+
+   trace build()
+   {
+      // releases the blocks that are still allocated, so that each replay starts from an empty allocator
+      while(!_live.empty())
+         deallocate_live(_live.size()-1);
+      return _trace;
+   }
+
+private:
+   trace _trace;
+   std::vector<size_t> _live;
+};
+
+trace make_lifo_trace()
+{
+   auto builder = trace_builder{ "LIFO" };
+   for(size_t i=0; i<CAPACITY; ++i)
+      builder.allocate();
+   while(builder.live() > 0)
+      builder.deallocate_live(builder.live()-1);
+   return builder.build();
+}
+
+trace make_fifo_trace()
+{
+   auto t = trace{ "FIFO", {}, CAPACITY };
+   for(size_t i=0; i<CAPACITY; ++i)
+      t.operations.push_back(trace_operation{ true, i });
+   for(size_t i=0; i<CAPACITY; ++i)
+      t.operations.push_back(trace_operation{ false, i });
+   return t;
+}
+
+// allocations and deallocations (of random blocks) with equal probability,
+// with occupancy kept between the specified bounds
+trace make_churn_trace(const char* name, size_t min_live, size_t max_live, size_t number_of_operations)
+{
+   auto generator = std::mt19937{ 0 };
+   auto builder = trace_builder{ name };
+   while(builder.live() < (min_live + max_live) / 2)
+      builder.allocate();
+   for(size_t i=0; i<number_of_operations; ++i)
+   {
+      auto allocate = std::bernoulli_distribution{ 0.5 }(generator);
+      if((allocate && builder.live() < max_live) || builder.live() <= min_live)
+      {
+         builder.allocate();
+      }
+      else
+      {
+         auto idx = std::uniform_int_distribution<size_t>{ 0, builder.live()-1 }(generator);
+         builder.deallocate_live(idx);
+      }
+   }
+   return builder.build();
+}
+
+trace make_random_churn_trace()
+{
+   return make_churn_trace("random churn", 0, CAPACITY, 4*CAPACITY);
+}
+
+trace make_near_full_trace()
+{
+   return make_churn_trace("steady state near full occupancy", CAPACITY - CAPACITY/32, CAPACITY, 4*CAPACITY);
+}
+
+struct malloc_adaptor
+{
+   static const char* name() { return "malloc/free"; }
+   void* allocate() { return std::malloc(sizeof(pod64)); }
+   void deallocate(void* p) { std::free(p); }
+   void after_allocate(void*, size_t) {}
+   void after_deallocate(void*) {}
+};
+
+struct freelist_allocator_adaptor
+{
+   static const char* name() { return "freelist_allocator"; }
+   void* allocate() { return allocator.allocate(); }
+   void deallocate(void* p) { allocator.deallocate(static_cast<pod64*>(p)); }
+   void after_allocate(void*, size_t) {}
+   void after_deallocate(void*) {}
+
+   sstl::freelist_allocator<pod64, CAPACITY> allocator;
+};
+
+// besides forwarding the calls to the allocator, it keeps track of the length of the
+// linear probe performed by bitmap_allocator::get_next_free_block_idx. The probe starts
+// at the block following _last_allocated_block_idx, which the allocator sets to the
+// predecessor of the deallocated block at each deallocation.
+struct bitmap_allocator_adaptor
+{
+   static const char* name() { return "bitmap_allocator"; }
+
+   bitmap_allocator_adaptor()
+   {
+      // the first allocation from a fresh allocator returns the first block of the pool
+      pool_begin = allocator.allocate();
+      allocator.deallocate(pool_begin);
+   }
+
+   void* allocate() { return allocator.allocate(); }
+   void deallocate(void* p) { allocator.deallocate(p); }
+
+   void after_allocate(void* p, size_t live_before_allocation)
+   {
+      auto idx = _index_of(p);
+      auto probe_start = (probe_start_idx + 1) % CAPACITY;
+      auto probe_length = (idx + CAPACITY - probe_start) % CAPACITY + 1;
+      auto bin = live_before_allocation * OCCUPANCY_BINS / CAPACITY;
+      probe_length_sum[bin] += probe_length;
+      ++probe_count[bin];
+   }
+
+   void after_deallocate(void* p)
+   {
+      probe_start_idx = _index_of(p) - 1;
+   }
+
+   size_t _index_of(void* p) const
+   {
+      return static_cast<size_t>(static_cast<pod64*>(p) - pool_begin);
+   }
+
+   sstl::bitmap_allocator<pod64, CAPACITY> allocator;
+   size_t probe_start_idx{ static_cast<size_t>(-1) };
+   pod64* pool_begin{ nullptr };
+   double probe_length_sum[OCCUPANCY_BINS] = {};
+   size_t probe_count[OCCUPANCY_BINS] = {};
+};
+
+template<class TAdaptor>
+void replay(TAdaptor& adaptor, const trace& t, operation_timer& allocations, operation_timer& deallocations)
+{
+   auto slots = std::vector<void*>(t.number_of_slots, nullptr);
+   size_t live = 0;
+   for(const auto& operation : t.operations)
+   {
+      if(operation.is_allocation)
+      {
+         allocations.start();
+         auto p = adaptor.allocate();
+         allocations.stop();
+         do_not_optimize(p);
+         adaptor.after_allocate(p, live);
+         slots[operation.slot] = p;
+         ++live;
+      }
+      else
+      {
+         auto p = slots[operation.slot];
+         deallocations.start();
+         adaptor.deallocate(p);
+         deallocations.stop();
+         adaptor.after_deallocate(p);
+         --live;
+      }
+   }
+}
+
+void print_probe_lengths(const bitmap_allocator_adaptor& adaptor)
+{
+   std::printf("   bitmap_allocator average probe length by occupancy:");
+   for(size_t bin=0; bin<OCCUPANCY_BINS; ++bin)
+   {
+      if(adaptor.probe_count[bin] > 0)
+         std::printf(" [%zu%%-%zu%%) %.1f",
+                     bin*100/OCCUPANCY_BINS, (bin+1)*100/OCCUPANCY_BINS,
+                     adaptor.probe_length_sum[bin] / adaptor.probe_count[bin]);
+   }
+   std::printf("\n");
+}
+
+void print_probe_lengths(const malloc_adaptor&) {}
+void print_probe_lengths(const freelist_allocator_adaptor&) {}
+
+template<class TAdaptor>
+void run(const trace& t)
+{
+   // heap allocated, since the allocators' pools might not fit on the stack
+   auto adaptor = std::unique_ptr<TAdaptor>(new TAdaptor());
+   auto allocations = operation_timer{};
+   auto deallocations = operation_timer{};
+
+   // warm-up (not measured)
+   auto warmup_timer = operation_timer{};
+   replay(*adaptor, t, warmup_timer, warmup_timer);
+
+   for(size_t i=0; i<TRACE_REPETITIONS; ++i)
+      replay(*adaptor, t, allocations, deallocations);
+
+   auto prefix = std::string{ TAdaptor::name() } + " (" + t.name + ") ";
+   report(prefix + "allocate", allocations);
+   report(prefix + "deallocate", deallocations);
+   print_probe_lengths(*adaptor);
+}
+
+void compare(const trace& t)
+{
+   run<bitmap_allocator_adaptor>(t);
+   run<freelist_allocator_adaptor>(t);
+   run<malloc_adaptor>(t);
+}
+
+SSTL_BENCHMARK_SUITE("allocator - bitmap_allocator vs freelist_allocator vs malloc/free (64-byte blocks, capacity 4096)")
+{
+   compare(make_lifo_trace());
+   compare(make_fifo_trace());
+   compare(make_random_churn_trace());
+   compare(make_near_full_trace());
+}
+
+}
+}
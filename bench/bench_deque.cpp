@@ -0,0 +1,333 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <deque>
+#include <random>
+#include <numeric>
+#include <type_traits>
+#include <sstl/deque.h>
+#include "benchmark.h"
+
+namespace sstl_bench
+{
+// internal linkage: the benchmark suites reuse the same helper names
+namespace
+{
+
+static const size_t OPERATIONS_PER_SAMPLE = 4096;
+static const size_t MIDDLE_INSERTION_SIZE = 8;
+static const size_t BATCH_SIZE = 8;
+
+// minimal ring buffer, used as a baseline for what a hand-written queue would cost
+template<class T, size_t CAPACITY>
+class ring_buffer
+{
+   static_assert(std::is_trivially_copyable<T>::value, "the baseline ring buffer supports only trivially copyable types");
+
+public:
+   using value_type = T;
+
+   void push_back(const T& value)
+   {
+      _buffer[_wrap(_first + _size)] = value;
+      ++_size;
+   }
+
+   void pop_front()
+   {
+      _first = _wrap(_first + 1);
+      --_size;
+   }
+
+   T& operator[](size_t idx)
+   {
+      return _buffer[_wrap(_first + idx)];
+   }
+
+   size_t size() const
+   {
+      return _size;
+   }
+
+private:
+   static size_t _wrap(size_t idx)
+   {
+      return idx >= CAPACITY ? idx - CAPACITY : idx;
+   }
+
+private:
+   size_t _first{ 0 };
+   size_t _size{ 0 };
+   T _buffer[CAPACITY];
+};
+
+// std::deque doesn't have a fixed capacity: the benchmarks just never exceed the specified one
+template<class T, size_t CAPACITY>
+class bounded_std_deque : public std::deque<T>
+{};
+
+// fills the container with the specified number of elements, arranged so that
+// (for the ring buffers) the stored elements wrap around the end of the storage
+template<class TContainer>
+void fill_wrapped(TContainer& c, size_t capacity, size_t count)
+{
+   for(size_t i=0; i<capacity-count/2; ++i)
+   {
+      c.push_back(typename TContainer::value_type{});
+      c.pop_front();
+   }
+   for(size_t i=0; i<count; ++i)
+      c.push_back(static_cast<typename TContainer::value_type>(i));
+}
+
+template<class TContainer>
+std::int64_t sum_all(TContainer& c)
+{
+   std::int64_t sum = 0;
+   for(const auto& value : c)
+      sum += value;
+   return sum;
+}
+
+template<class T, size_t CAPACITY>
+std::int64_t sum_all(ring_buffer<T, CAPACITY>& c)
+{
+   std::int64_t sum = 0;
+   for(size_t i=0; i<c.size(); ++i)
+      sum += c[i];
+   return sum;
+}
+
+template<class TContainer, size_t CAPACITY>
+struct steady_state_push_pop_benchmark
+{
+   static const char* name() { return "push_back + pop_front (steady state)"; }
+
+   steady_state_push_pop_benchmark()
+   {
+      fill_wrapped(c, CAPACITY, CAPACITY/2);
+   }
+
+   void operator()(sample_timer& timer)
+   {
+      timer.start();
+      for(size_t i=0; i<OPERATIONS_PER_SAMPLE; ++i)
+      {
+         c.push_back(static_cast<typename TContainer::value_type>(i));
+         c.pop_front();
+      }
+      timer.stop(OPERATIONS_PER_SAMPLE);
+      do_not_optimize(c);
+   }
+
+   TContainer c;
+};
+
+// the containers without batched operations transfer the batches element by element
+template<class TContainer>
+void push_back_batch(TContainer& c, const typename TContainer::value_type* batch, size_t count)
+{
+   for(size_t i=0; i<count; ++i)
+      c.push_back(batch[i]);
+}
+
+template<class TContainer>
+void pop_front_batch(TContainer& c, typename TContainer::value_type* batch, size_t count)
+{
+   for(size_t i=0; i<count; ++i)
+   {
+      batch[i] = c[0];
+      c.pop_front();
+   }
+}
+
+template<class T, size_t CAPACITY>
+void push_back_batch(sstl::deque<T, CAPACITY>& c, const T* batch, size_t count)
+{
+   c.push_back_n(batch, count);
+}
+
+template<class T, size_t CAPACITY>
+void pop_front_batch(sstl::deque<T, CAPACITY>& c, T* batch, size_t count)
+{
+   c.pop_front_n(batch, count);
+}
+
+template<class TContainer, size_t CAPACITY>
+struct batch_push_pop_benchmark
+{
+   static const char* name() { return "push_back + pop_front (batches of 8 elements)"; }
+
+   batch_push_pop_benchmark()
+   {
+      fill_wrapped(c, CAPACITY, CAPACITY/2);
+      for(size_t i=0; i<BATCH_SIZE; ++i)
+         batch[i] = static_cast<typename TContainer::value_type>(i);
+   }
+
+   void operator()(sample_timer& timer)
+   {
+      timer.start();
+      for(size_t i=0; i<OPERATIONS_PER_SAMPLE; i+=BATCH_SIZE)
+      {
+         push_back_batch(c, batch, BATCH_SIZE);
+         pop_front_batch(c, batch, BATCH_SIZE);
+      }
+      timer.stop(OPERATIONS_PER_SAMPLE);
+      do_not_optimize(c);
+   }
+
+   TContainer c;
+   typename TContainer::value_type batch[BATCH_SIZE];
+};
+
+template<class TContainer, size_t CAPACITY>
+struct random_access_benchmark
+{
+   static const char* name() { return "operator[] (random index)"; }
+
+   random_access_benchmark()
+   {
+      fill_wrapped(c, CAPACITY, CAPACITY);
+      auto generator = std::mt19937{ 0 };
+      auto distribution = std::uniform_int_distribution<size_t>{ 0, CAPACITY-1 };
+      indices.reserve(OPERATIONS_PER_SAMPLE);
+      for(size_t i=0; i<OPERATIONS_PER_SAMPLE; ++i)
+         indices.push_back(distribution(generator));
+   }
+
+   void operator()(sample_timer& timer)
+   {
+      std::int64_t sum = 0;
+      timer.start();
+      for(auto idx : indices)
+         sum += c[idx];
+      timer.stop(OPERATIONS_PER_SAMPLE);
+      do_not_optimize(sum);
+   }
+
+   TContainer c;
+   std::vector<size_t> indices;
+};
+
+template<class TContainer, size_t CAPACITY>
+struct traversal_benchmark
+{
+   static const char* name() { return "traversal (full, wrapped)"; }
+
+   traversal_benchmark()
+   {
+      fill_wrapped(c, CAPACITY, CAPACITY);
+   }
+
+   void operator()(sample_timer& timer)
+   {
+      timer.start();
+      auto sum = sum_all(c);
+      timer.stop(CAPACITY);
+      do_not_optimize(sum);
+   }
+
+   TContainer c;
+};
+
+// same as traversal_benchmark, but with sstl::deque's linear iterators
+template<class TContainer, size_t CAPACITY>
+struct linear_traversal_benchmark
+{
+   static const char* name() { return "traversal with linear iterators (full, wrapped)"; }
+
+   linear_traversal_benchmark()
+   {
+      fill_wrapped(c, CAPACITY, CAPACITY);
+   }
+
+   void operator()(sample_timer& timer)
+   {
+      timer.start();
+      auto sum = std::accumulate(c.linear_begin(), c.linear_end(), std::int64_t{ 0 });
+      timer.stop(CAPACITY);
+      do_not_optimize(sum);
+   }
+
+   TContainer c;
+};
+
+template<class TContainer, size_t CAPACITY>
+struct middle_insert_erase_benchmark
+{
+   static const char* name() { return "insert + erase of 8 elements (middle)"; }
+
+   middle_insert_erase_benchmark()
+   {
+      fill_wrapped(c, CAPACITY, CAPACITY/2);
+   }
+
+   void operator()(sample_timer& timer)
+   {
+      // insertion position is closer to the begin, i.e. the elements
+      // in [begin, pos) get shifted towards the front
+      auto offset = c.size()/2 - 1;
+      timer.start();
+      c.insert(c.begin() + offset, MIDDLE_INSERTION_SIZE, typename TContainer::value_type{});
+      c.erase(c.begin() + offset, c.begin() + offset + MIDDLE_INSERTION_SIZE);
+      timer.stop();
+      do_not_optimize(c);
+   }
+
+   TContainer c;
+};
+
+template<template<class, size_t> class TBenchmark, class TContainer, size_t CAPACITY>
+void run(const std::string& container_name)
+{
+   // heap allocated, since the large containers wouldn't fit on the stack
+   auto benchmark = std::unique_ptr<TBenchmark<TContainer, CAPACITY>>(new TBenchmark<TContainer, CAPACITY>());
+   auto name = container_name + "<int, " + std::to_string(CAPACITY) + "> " + TBenchmark<TContainer, CAPACITY>::name();
+   measure(name, [&benchmark](sample_timer& timer){ (*benchmark)(timer); });
+}
+
+template<size_t CAPACITY>
+void compare_all()
+{
+   run<steady_state_push_pop_benchmark, sstl::deque<int, CAPACITY>, CAPACITY>("sstl::deque");
+   run<steady_state_push_pop_benchmark, bounded_std_deque<int, CAPACITY>, CAPACITY>("std::deque");
+   run<steady_state_push_pop_benchmark, ring_buffer<int, CAPACITY>, CAPACITY>("ring_buffer");
+
+   run<batch_push_pop_benchmark, sstl::deque<int, CAPACITY>, CAPACITY>("sstl::deque");
+   run<batch_push_pop_benchmark, bounded_std_deque<int, CAPACITY>, CAPACITY>("std::deque");
+   run<batch_push_pop_benchmark, ring_buffer<int, CAPACITY>, CAPACITY>("ring_buffer");
+
+   run<random_access_benchmark, sstl::deque<int, CAPACITY>, CAPACITY>("sstl::deque");
+   run<random_access_benchmark, bounded_std_deque<int, CAPACITY>, CAPACITY>("std::deque");
+   run<random_access_benchmark, ring_buffer<int, CAPACITY>, CAPACITY>("ring_buffer");
+
+   run<traversal_benchmark, sstl::deque<int, CAPACITY>, CAPACITY>("sstl::deque");
+   run<traversal_benchmark, bounded_std_deque<int, CAPACITY>, CAPACITY>("std::deque");
+   run<traversal_benchmark, ring_buffer<int, CAPACITY>, CAPACITY>("ring_buffer");
+   run<linear_traversal_benchmark, sstl::deque<int, CAPACITY>, CAPACITY>("sstl::deque");
+
+   // the baseline ring buffer doesn't support insertions/erasures in the middle
+   run<middle_insert_erase_benchmark, sstl::deque<int, CAPACITY>, CAPACITY>("sstl::deque");
+   run<middle_insert_erase_benchmark, bounded_std_deque<int, CAPACITY>, CAPACITY>("std::deque");
+}
+
+SSTL_BENCHMARK_SUITE("deque - sstl::deque vs std::deque vs ring buffer (capacity 16 to 1M)")
+{
+   compare_all<16>();
+   compare_all<256>();
+   compare_all<4096>();
+   compare_all<65536>();
+   compare_all<1048576>();
+}
+
+}
+}
@@ -0,0 +1,332 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <functional>
+#include <algorithm>
+#include <sstl/vector.h>
+#include <sstl/function.h>
+#include "benchmark.h"
+
+namespace sstl_bench
+{
+// internal linkage: the benchmark suites reuse the same helper names
+namespace
+{
+
+static const size_t OPERATIONS_PER_SAMPLE = 4096;
+
+// function object whose size is exactly the specified one
+template<size_t SIZE>
+struct sized_callable
+{
+   sized_callable()
+   {
+      for(auto& byte : payload)
+         byte = 1;
+   }
+
+   int operator()(int value) const
+   {
+      return value + payload[SIZE-1];
+   }
+
+   std::uint8_t payload[SIZE];
+};
+
+static int free_function(int value)
+{
+   return value + 1;
+}
+
+static double free_function_with_two_parameters(int i, double d)
+{
+   return i * 0.5 + d * 0.5;
+}
+
+// reference for the dispatch of sstl::function: the previous design, i.e. the target is wrapped
+// in a polymorphic callable constructed in the buffer and invoked through its vtable
+struct polymorphic_callable
+{
+   virtual ~polymorphic_callable() {}
+   virtual int operator()(int) = 0;
+};
+
+template<class TTarget>
+struct polymorphic_callable_imp : polymorphic_callable
+{
+   explicit polymorphic_callable_imp(const TTarget& target) : target(target) {}
+   int operator()(int value) override { return target(value); }
+   TTarget target;
+};
+
+template<size_t SIZE>
+class vtable_function
+{
+public:
+   template<class TTarget>
+   explicit vtable_function(TTarget target)
+   {
+      static_assert(sizeof(polymorphic_callable_imp<TTarget>) <= sizeof(buffer), "the target doesn't fit in the buffer");
+      new(&buffer) polymorphic_callable_imp<TTarget>(target);
+      do_not_optimize(buffer); // as if constructed elsewhere, i.e. the dynamic type isn't known at the call site
+   }
+
+   vtable_function(const vtable_function&) = delete;
+   vtable_function& operator=(const vtable_function&) = delete;
+
+   ~vtable_function()
+   {
+      get_callable().~polymorphic_callable();
+   }
+
+   int operator()(int value) const
+   {
+      return get_callable()(value);
+   }
+
+private:
+   polymorphic_callable& get_callable() const
+   {
+      return *reinterpret_cast<polymorphic_callable*>(const_cast<void*>(static_cast<const void*>(&buffer)));
+   }
+
+   typename std::aligned_storage<SIZE + sizeof(void*), std::alignment_of<void*>::value>::type buffer;
+};
+
+template<class TFunction>
+struct invocation_benchmark
+{
+   template<class TTarget>
+   explicit invocation_benchmark(TTarget target) : f(target) {}
+
+   void operator()(sample_timer& timer)
+   {
+      int sum = 0;
+      timer.start();
+      for(size_t i=0; i<OPERATIONS_PER_SAMPLE; ++i)
+         sum += f(static_cast<int>(i));
+      timer.stop(OPERATIONS_PER_SAMPLE);
+      do_not_optimize(sum);
+   }
+
+   TFunction f;
+};
+
+template<class TFunction>
+struct two_parameters_invocation_benchmark
+{
+   template<class TTarget>
+   explicit two_parameters_invocation_benchmark(TTarget target) : f(target) {}
+
+   void operator()(sample_timer& timer)
+   {
+      double sum = 0.0;
+      timer.start();
+      for(size_t i=0; i<OPERATIONS_PER_SAMPLE; ++i)
+         sum += f(static_cast<int>(i), sum);
+      timer.stop(OPERATIONS_PER_SAMPLE);
+      do_not_optimize(sum);
+   }
+
+   TFunction f;
+};
+
+template<class TFunction>
+struct bool_test_benchmark
+{
+   template<class TTarget>
+   explicit bool_test_benchmark(TTarget target) : f(target) {}
+
+   void operator()(sample_timer& timer)
+   {
+      size_t count = 0;
+      timer.start();
+      for(size_t i=0; i<OPERATIONS_PER_SAMPLE; ++i)
+      {
+         clobber_memory(); // forces the test to be performed at each iteration
+         if(f)
+            ++count;
+      }
+      timer.stop(OPERATIONS_PER_SAMPLE);
+      do_not_optimize(count);
+   }
+
+   TFunction f;
+};
+
+// default construction (reset to the empty state) + test of the empty function
+template<class TFunction>
+struct empty_function_benchmark
+{
+   void operator()(sample_timer& timer)
+   {
+      size_t count = 0;
+      timer.start();
+      for(size_t i=0; i<OPERATIONS_PER_SAMPLE; ++i)
+      {
+         TFunction f;
+         do_not_optimize(f);
+         if(f)
+            ++count;
+      }
+      timer.stop(OPERATIONS_PER_SAMPLE);
+      do_not_optimize(count);
+   }
+};
+
+template<class TFunction, class TTarget>
+struct construction_benchmark
+{
+   void operator()(sample_timer& timer)
+   {
+      timer.start();
+      for(size_t i=0; i<OPERATIONS_PER_SAMPLE; ++i)
+      {
+         TFunction f{ target };
+         do_not_optimize(f);
+      }
+      timer.stop(OPERATIONS_PER_SAMPLE);
+   }
+
+   TTarget target;
+};
+
+template<class TFunction>
+struct copy_construction_benchmark
+{
+   template<class TTarget>
+   explicit copy_construction_benchmark(TTarget target) : src(target) {}
+
+   void operator()(sample_timer& timer)
+   {
+      timer.start();
+      for(size_t i=0; i<OPERATIONS_PER_SAMPLE; ++i)
+      {
+         TFunction f{ src };
+         do_not_optimize(f);
+      }
+      timer.stop(OPERATIONS_PER_SAMPLE);
+   }
+
+   TFunction src;
+};
+
+template<class TFunction>
+struct move_assignment_benchmark
+{
+   template<class TTarget>
+   explicit move_assignment_benchmark(TTarget target) : lhs(target), rhs(target) {}
+
+   void operator()(sample_timer& timer)
+   {
+      timer.start();
+      for(size_t i=0; i<OPERATIONS_PER_SAMPLE/2; ++i)
+      {
+         lhs = std::move(rhs);
+         rhs = std::move(lhs);
+         clobber_memory();
+      }
+      timer.stop(OPERATIONS_PER_SAMPLE/2*2);
+      do_not_optimize(rhs);
+   }
+
+   TFunction lhs;
+   TFunction rhs;
+};
+
+// rotation of a vector of functions (one move construction and one move assignment per element)
+template<class TFunction, size_t COUNT>
+struct vector_rotation_benchmark
+{
+   template<class TTarget>
+   explicit vector_rotation_benchmark(TTarget target) : functions(COUNT, TFunction(target)) {}
+
+   void operator()(sample_timer& timer)
+   {
+      timer.start();
+      for(size_t i=0; i<OPERATIONS_PER_SAMPLE/COUNT; ++i)
+      {
+         std::rotate(functions.begin(), functions.begin()+1, functions.end());
+         clobber_memory();
+      }
+      timer.stop(OPERATIONS_PER_SAMPLE/COUNT*COUNT);
+   }
+
+   sstl::vector<TFunction, COUNT> functions;
+};
+
+template<class TBenchmark>
+void run(const std::string& name, TBenchmark* raw_benchmark)
+{
+   auto benchmark = std::unique_ptr<TBenchmark>(raw_benchmark);
+   measure(name, [&benchmark](sample_timer& timer){ (*benchmark)(timer); });
+}
+
+template<size_t SIZE>
+void compare_all()
+{
+   using target = sized_callable<SIZE>;
+   using sstl_function = sstl::function<int(int), SIZE>;
+   using std_function = std::function<int(int)>;
+   auto suffix = std::string{ " (callable size " } + std::to_string(SIZE) + ")";
+
+   run("sstl::function invocation" + suffix, new invocation_benchmark<sstl_function>(target{}));
+   run("std::function invocation" + suffix, new invocation_benchmark<std_function>(target{}));
+   run("vtable dispatch invocation" + suffix, new invocation_benchmark<vtable_function<SIZE>>(target{}));
+   run("direct invocation" + suffix, new invocation_benchmark<target>(target{}));
+
+   run("sstl::function operator bool" + suffix, new bool_test_benchmark<sstl_function>(target{}));
+   run("std::function operator bool" + suffix, new bool_test_benchmark<std_function>(target{}));
+   run("sstl::function empty construction + operator bool" + suffix, new empty_function_benchmark<sstl_function>());
+   run("std::function empty construction + operator bool" + suffix, new empty_function_benchmark<std_function>());
+
+   run("sstl::function construction + destruction" + suffix, new construction_benchmark<sstl_function, target>());
+   run("std::function construction + destruction" + suffix, new construction_benchmark<std_function, target>());
+
+   run("sstl::function copy construction + destruction" + suffix, new copy_construction_benchmark<sstl_function>(target{}));
+   run("std::function copy construction + destruction" + suffix, new copy_construction_benchmark<std_function>(target{}));
+
+   run("sstl::function move assignment" + suffix, new move_assignment_benchmark<sstl_function>(target{}));
+   run("std::function move assignment" + suffix, new move_assignment_benchmark<std_function>(target{}));
+
+   run("sstl::vector<sstl::function> rotation" + suffix, new vector_rotation_benchmark<sstl_function, 64>(target{}));
+   run("sstl::vector<std::function> rotation" + suffix, new vector_rotation_benchmark<std_function, 64>(target{}));
+}
+
+SSTL_BENCHMARK_SUITE("function - sstl::function vs std::function vs vtable dispatch vs function pointer vs direct call")
+{
+   using function_pointer = int(*)(int);
+   run("function pointer invocation", new invocation_benchmark<function_pointer>(&free_function));
+   run("sstl::function invocation (function pointer target)",
+       new invocation_benchmark<sstl::function<int(int), sizeof(function_pointer)>>(&free_function));
+   run("std::function invocation (function pointer target)",
+       new invocation_benchmark<std::function<int(int)>>(&free_function));
+   run("vtable dispatch invocation (function pointer target)",
+       new invocation_benchmark<vtable_function<sizeof(function_pointer)>>(&free_function));
+
+   using two_parameters_function_pointer = double(*)(int, double);
+   run("function pointer invocation (int and double parameters)",
+       new two_parameters_invocation_benchmark<two_parameters_function_pointer>(&free_function_with_two_parameters));
+   run("sstl::function invocation (int and double parameters)",
+       new two_parameters_invocation_benchmark<sstl::function<double(int, double), sizeof(two_parameters_function_pointer)>>(
+         &free_function_with_two_parameters));
+   run("std::function invocation (int and double parameters)",
+       new two_parameters_invocation_benchmark<std::function<double(int, double)>>(&free_function_with_two_parameters));
+
+   compare_all<8>();
+   compare_all<32>();
+   compare_all<64>();
+   compare_all<256>();
+}
+
+}
+}
@@ -0,0 +1,95 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <cstdint>
+#include <string>
+#include <functional>
+#include <sstl/function.h>
+#include <sstl/function_ref.h>
+#include "benchmark.h"
+
+namespace sstl_bench
+{
+// internal linkage: the benchmark suites reuse the same helper names
+namespace
+{
+
+static const size_t VISITS_PER_SAMPLE = 1024;
+static const size_t LEVELS = 16;
+static const size_t CAPTURES_SIZE = 4*sizeof(void*);
+
+#if _is_msvc()
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+struct level
+{
+   std::int64_t price;
+   std::int64_t quantity;
+};
+
+// the visitors are not inlined, as if they were defined in another translation unit
+template<class TVisitor>
+NOINLINE void visit_levels(const level* levels, const TVisitor& visitor)
+{
+   for(size_t i=0; i<LEVELS; ++i)
+      visitor(levels[i]);
+}
+
+NOINLINE void visit_levels(const level* levels, sstl::function_ref<void(const level&)> visitor)
+{
+   for(size_t i=0; i<LEVELS; ++i)
+      visitor(levels[i]);
+}
+
+// each visit passes a new closure, whose captures are as large as the specified size
+template<class TVisitor>
+void visit_benchmark(const std::string& name)
+{
+   level levels[LEVELS];
+   for(size_t i=0; i<LEVELS; ++i)
+      levels[i] = level{ static_cast<std::int64_t>(i), static_cast<std::int64_t>(i) };
+
+   measure(name, [&](sample_timer& timer)
+   {
+      std::int64_t notional = 0;
+      std::int64_t quantity = 0;
+      std::int64_t min_price = 0;
+      std::int64_t max_price = 0;
+      timer.start();
+      for(size_t i=0; i<VISITS_PER_SAMPLE; ++i)
+      {
+         auto closure = [&notional, &quantity, &min_price, &max_price](const level& l)
+         {
+            notional += l.price * l.quantity;
+            quantity += l.quantity;
+            min_price = l.price < min_price ? l.price : min_price;
+            max_price = l.price > max_price ? l.price : max_price;
+         };
+         static_assert(sizeof(closure) <= CAPTURES_SIZE, "the closure doesn't fit in the sstl::function");
+         visit_levels(levels, TVisitor(closure));
+         clobber_memory();
+      }
+      timer.stop(VISITS_PER_SAMPLE);
+      do_not_optimize(notional);
+      do_not_optimize(quantity);
+      do_not_optimize(min_price);
+      do_not_optimize(max_price);
+   });
+}
+
+SSTL_BENCHMARK_SUITE("function_ref - visit of 16 levels with a callback vs sstl::function vs std::function")
+{
+   visit_benchmark<sstl::function_ref<void(const level&)>>("sstl::function_ref visit");
+   visit_benchmark<sstl::function<void(const level&), CAPTURES_SIZE>>("sstl::function visit");
+   visit_benchmark<std::function<void(const level&)>>("std::function visit");
+}
+
+}
+}
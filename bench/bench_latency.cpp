@@ -0,0 +1,148 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <random>
+#include <sstl/vector.h>
+#include <sstl/deque.h>
+#include "benchmark.h"
+
+namespace sstl_bench
+{
+// internal linkage: the benchmark suites reuse the same helper names
+namespace
+{
+
+// number of timed operations per configured sample, i.e. 100000 operations with the
+// default configuration, which is enough for a meaningful p99.99
+static const size_t OPERATIONS_PER_SAMPLE = 500;
+
+size_t number_of_operations()
+{
+   return global_configuration().samples * OPERATIONS_PER_SAMPLE;
+}
+
+std::vector<size_t> make_random_positions(size_t count, size_t max_position)
+{
+   auto generator = std::mt19937{ 0 };
+   auto distribution = std::uniform_int_distribution<size_t>{ 0, max_position };
+   auto positions = std::vector<size_t>{};
+   positions.reserve(count);
+   for(size_t i=0; i<count; ++i)
+      positions.push_back(distribution(generator));
+   return positions;
+}
+
+std::string make_name(const char* container_name, size_t capacity, const char* operation)
+{
+   return std::string{ container_name } + "<int, " + std::to_string(capacity) + "> " + operation;
+}
+
+// times each single insertion and erasure at random positions while the container
+// is kept (nearly) full, i.e. where shifting the elements costs the most
+template<class TContainer, size_t CAPACITY>
+void insert_erase_at_random_positions(const char* container_name)
+{
+   // heap allocated, since the large containers wouldn't fit on the stack
+   auto c = std::unique_ptr<TContainer>(new TContainer());
+   for(size_t i=0; i<CAPACITY-1; ++i)
+      c->push_back(static_cast<int>(i));
+
+   auto operations = number_of_operations();
+   auto erase_positions = make_random_positions(operations, CAPACITY-2);
+   auto insert_positions = make_random_positions(operations, CAPACITY-2);
+   auto erasures = operation_timer{};
+   auto insertions = operation_timer{};
+   for(size_t i=0; i<operations; ++i)
+   {
+      auto erase_position = c->begin() + erase_positions[i];
+      erasures.start();
+      c->erase(erase_position);
+      erasures.stop();
+
+      auto insert_position = c->begin() + insert_positions[i];
+      insertions.start();
+      c->insert(insert_position, static_cast<int>(i));
+      insertions.stop();
+   }
+   do_not_optimize(*c);
+
+   report(make_name(container_name, CAPACITY, "erase (random position, full)"), erasures);
+   report(make_name(container_name, CAPACITY, "insert (random position, full)"), insertions);
+}
+
+template<size_t CAPACITY>
+void vector_push_back_pop_back()
+{
+   auto v = std::unique_ptr<sstl::vector<int, CAPACITY>>(new sstl::vector<int, CAPACITY>());
+   for(size_t i=0; i<CAPACITY-1; ++i)
+      v->push_back(static_cast<int>(i));
+
+   auto push_backs = operation_timer{};
+   auto pop_backs = operation_timer{};
+   for(size_t i=0, operations=number_of_operations(); i<operations; ++i)
+   {
+      push_backs.start();
+      v->push_back(static_cast<int>(i));
+      push_backs.stop();
+
+      pop_backs.start();
+      v->pop_back();
+      pop_backs.stop();
+   }
+   do_not_optimize(*v);
+
+   report(make_name("sstl::vector", CAPACITY, "push_back"), push_backs);
+   report(make_name("sstl::vector", CAPACITY, "pop_back"), pop_backs);
+}
+
+template<size_t CAPACITY>
+void deque_push_back_pop_front()
+{
+   auto d = std::unique_ptr<sstl::deque<int, CAPACITY>>(new sstl::deque<int, CAPACITY>());
+   for(size_t i=0; i<CAPACITY-1; ++i)
+      d->push_back(static_cast<int>(i));
+
+   auto push_backs = operation_timer{};
+   auto pop_fronts = operation_timer{};
+   for(size_t i=0, operations=number_of_operations(); i<operations; ++i)
+   {
+      push_backs.start();
+      d->push_back(static_cast<int>(i));
+      push_backs.stop();
+
+      pop_fronts.start();
+      d->pop_front();
+      pop_fronts.stop();
+   }
+   do_not_optimize(*d);
+
+   report(make_name("sstl::deque", CAPACITY, "push_back (wrapping)"), push_backs);
+   report(make_name("sstl::deque", CAPACITY, "pop_front (wrapping)"), pop_fronts);
+}
+
+template<size_t CAPACITY>
+void run_all()
+{
+   vector_push_back_pop_back<CAPACITY>();
+   insert_erase_at_random_positions<sstl::vector<int, CAPACITY>, CAPACITY>("sstl::vector");
+   deque_push_back_pop_front<CAPACITY>();
+   insert_erase_at_random_positions<sstl::deque<int, CAPACITY>, CAPACITY>("sstl::deque");
+}
+
+SSTL_BENCHMARK_SUITE("latency - worst-case cost of single operations (capacity 16 to 64K)")
+{
+   run_all<16>();
+   run_all<256>();
+   run_all<4096>();
+   run_all<65536>();
+}
+
+}
+}
@@ -0,0 +1,126 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sstl/queue.h>
+#include <sstl/mpmc_queue.h>
+#include "benchmark.h"
+
+namespace sstl_bench
+{
+// internal linkage: the benchmark suites reuse the same helper names
+namespace
+{
+
+static const size_t QUEUE_CAPACITY = 1024;
+static const size_t ITEMS_PER_SAMPLE = 64 * 1024;
+// the waiting threads spin for a while before yielding the CPU to the other threads
+// (which matters only if there are more threads than cores)
+static const unsigned SPINS_BEFORE_YIELD = 64;
+
+// baseline: sstl::queue protected by a mutex
+template<class T, size_t CAPACITY>
+class locked_queue
+{
+public:
+   bool try_push(const T& value)
+   {
+      std::lock_guard<std::mutex> lock{ _mutex };
+      if(_queue.size() == CAPACITY)
+         return false;
+      _queue.push(value);
+      return true;
+   }
+
+   bool try_pop(T& value)
+   {
+      std::lock_guard<std::mutex> lock{ _mutex };
+      if(_queue.empty())
+         return false;
+      value = _queue.front();
+      _queue.pop();
+      return true;
+   }
+
+private:
+   std::mutex _mutex;
+   sstl::queue<T, CAPACITY> _queue;
+};
+
+template<class TPredicate>
+void spin_until(TPredicate is_done)
+{
+   for(unsigned spins=0; !is_done(); ++spins)
+   {
+      if(spins >= SPINS_BEFORE_YIELD)
+         std::this_thread::yield();
+   }
+}
+
+// the producers and the consumers transfer ITEMS_PER_SAMPLE items in total (the thread
+// creation is included in the measured time, but it is negligible compared to the transfers)
+template<class TQueue>
+void transfer_throughput(const std::string& name, size_t producers, size_t consumers)
+{
+   //on the stack: heap allocations aren't guaranteed to respect the queue's cache line alignment (C++11)
+   TQueue queue;
+   auto full_name = name + " (" + std::to_string(producers) + " producers, "
+                    + std::to_string(consumers) + " consumers)";
+
+   measure(full_name, [&](sample_timer& timer)
+   {
+      auto threads = std::vector<std::thread>{};
+      timer.start();
+      for(size_t p=0; p<producers; ++p)
+      {
+         auto items = ITEMS_PER_SAMPLE / producers + (p < ITEMS_PER_SAMPLE % producers ? 1 : 0);
+         threads.emplace_back([&queue, items]()
+         {
+            for(std::uint64_t i=0; i<items; ++i)
+               spin_until([&]{ return queue.try_push(i); });
+         });
+      }
+      for(size_t c=0; c<consumers; ++c)
+      {
+         auto items = ITEMS_PER_SAMPLE / consumers + (c < ITEMS_PER_SAMPLE % consumers ? 1 : 0);
+         threads.emplace_back([&queue, items]()
+         {
+            std::uint64_t value = 0;
+            for(size_t i=0; i<items; ++i)
+               spin_until([&]{ return queue.try_pop(value); });
+            do_not_optimize(value);
+         });
+      }
+      for(auto& thread : threads)
+         thread.join();
+      timer.stop(ITEMS_PER_SAMPLE);
+   });
+}
+
+template<class TQueue>
+void scale(const std::string& name)
+{
+   transfer_throughput<TQueue>(name, 1, 1);
+   transfer_throughput<TQueue>(name, 2, 2);
+   transfer_throughput<TQueue>(name, 4, 4);
+   transfer_throughput<TQueue>(name, 8, 8);
+   transfer_throughput<TQueue>(name, 15, 1);
+}
+
+SSTL_BENCHMARK_SUITE("mpmc_queue - throughput with 2 to 16 threads vs locked sstl::queue")
+{
+   scale<sstl::mpmc_queue<std::uint64_t, QUEUE_CAPACITY>>("sstl::mpmc_queue");
+   scale<locked_queue<std::uint64_t, QUEUE_CAPACITY>>("locked sstl::queue");
+}
+
+}
+}
@@ -0,0 +1,186 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <sstl/deque.h>
+#include <sstl/spsc_queue.h>
+#include "benchmark.h"
+
+namespace sstl_bench
+{
+// internal linkage: the benchmark suites reuse the same helper names
+namespace
+{
+
+static const size_t QUEUE_CAPACITY = 1024;
+static const size_t ROUND_TRIPS_PER_SAMPLE = 1000;
+static const size_t ITEMS_PER_SAMPLE = 64 * 1024;
+// the waiting threads spin for a while before yielding the CPU to the other thread
+// (which matters only if both threads share the same core)
+static const unsigned SPINS_BEFORE_YIELD = 1000;
+
+// baseline: the deque protected by a mutex
+template<class T, size_t CAPACITY>
+class locked_deque
+{
+public:
+   bool try_push(const T& value)
+   {
+      std::lock_guard<std::mutex> lock{ _mutex };
+      if(_deque.full())
+         return false;
+      _deque.push_back(value);
+      return true;
+   }
+
+   bool try_pop(T& value)
+   {
+      std::lock_guard<std::mutex> lock{ _mutex };
+      if(_deque.empty())
+         return false;
+      value = _deque.front();
+      _deque.pop_front();
+      return true;
+   }
+
+   size_t try_push_n(const T* values, size_t count)
+   {
+      std::lock_guard<std::mutex> lock{ _mutex };
+      count = std::min(count, _deque.capacity() - _deque.size());
+      _deque.push_back_n(values, count);
+      return count;
+   }
+
+   size_t try_pop_n(T* values, size_t count)
+   {
+      std::lock_guard<std::mutex> lock{ _mutex };
+      count = std::min(count, _deque.size());
+      _deque.pop_front_n(values, count);
+      return count;
+   }
+
+private:
+   std::mutex _mutex;
+   sstl::deque<T, CAPACITY> _deque;
+};
+
+template<class TPredicate>
+void spin_until(TPredicate is_done)
+{
+   for(unsigned spins=0; !is_done(); ++spins)
+   {
+      if(spins >= SPINS_BEFORE_YIELD)
+         std::this_thread::yield();
+   }
+}
+
+// the benchmark thread sends a value through one queue, another thread sends it back through
+// a second queue: half of the round trip is the latency of handing off a single item
+template<class TQueue>
+void handoff_latency(const std::string& name)
+{
+   auto ping = std::unique_ptr<TQueue>(new TQueue());
+   auto pong = std::unique_ptr<TQueue>(new TQueue());
+   std::atomic<bool> is_stopped{ false };
+
+   auto echo = std::thread([&]()
+   {
+      std::uint64_t value = 0;
+      for(;;)
+      {
+         spin_until([&]{ return ping->try_pop(value) || is_stopped.load(std::memory_order_relaxed); });
+         if(is_stopped.load(std::memory_order_relaxed))
+            return;
+         spin_until([&]{ return pong->try_push(value); });
+      }
+   });
+
+   measure(name + " handoff (ping-pong, 1 item)", [&](sample_timer& timer)
+   {
+      std::uint64_t value = 0;
+      timer.start();
+      for(std::uint64_t i=0; i<ROUND_TRIPS_PER_SAMPLE; ++i)
+      {
+         spin_until([&]{ return ping->try_push(i); });
+         spin_until([&]{ return pong->try_pop(value); });
+      }
+      timer.stop(2*ROUND_TRIPS_PER_SAMPLE);
+      do_not_optimize(value);
+   });
+
+   is_stopped = true;
+   echo.join();
+}
+
+// another thread streams the items in batches to the benchmark thread
+template<class TQueue, size_t BATCH_SIZE>
+void streaming_throughput(const std::string& name)
+{
+   auto queue = std::unique_ptr<TQueue>(new TQueue());
+   std::atomic<size_t> items_to_produce{ 0 };
+   std::atomic<bool> is_stopped{ false };
+
+   auto producer = std::thread([&]()
+   {
+      std::uint64_t batch[BATCH_SIZE] = {};
+      for(;;)
+      {
+         size_t items = 0;
+         spin_until([&]{ return (items = items_to_produce.exchange(0)) > 0 || is_stopped.load(std::memory_order_relaxed); });
+         if(items == 0)
+            return;
+         while(items > 0)
+         {
+            auto pushed = queue->try_push_n(batch, std::min(items, BATCH_SIZE));
+            if(pushed == 0)
+               std::this_thread::yield();
+            items -= pushed;
+         }
+      }
+   });
+
+   measure(name + " streaming (batches of " + std::to_string(BATCH_SIZE) + ")", [&](sample_timer& timer)
+   {
+      std::uint64_t batch[BATCH_SIZE];
+      size_t popped = 0;
+      timer.start();
+      items_to_produce = ITEMS_PER_SAMPLE;
+      while(popped < ITEMS_PER_SAMPLE)
+      {
+         auto count = queue->try_pop_n(batch, BATCH_SIZE);
+         if(count == 0)
+            std::this_thread::yield();
+         popped += count;
+      }
+      timer.stop(ITEMS_PER_SAMPLE);
+      do_not_optimize(batch);
+   });
+
+   is_stopped = true;
+   producer.join();
+}
+
+SSTL_BENCHMARK_SUITE("spsc_queue - handoff between two threads vs locked sstl::deque")
+{
+   using spsc_queue_type = sstl::spsc_queue<std::uint64_t, QUEUE_CAPACITY>;
+   using locked_deque_type = locked_deque<std::uint64_t, QUEUE_CAPACITY>;
+
+   handoff_latency<spsc_queue_type>("sstl::spsc_queue");
+   handoff_latency<locked_deque_type>("locked sstl::deque");
+   streaming_throughput<spsc_queue_type, 1>("sstl::spsc_queue");
+   streaming_throughput<locked_deque_type, 1>("locked sstl::deque");
+   streaming_throughput<spsc_queue_type, 32>("sstl::spsc_queue");
+   streaming_throughput<locked_deque_type, 32>("locked sstl::deque");
+}
+
+}
+}
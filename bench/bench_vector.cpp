@@ -0,0 +1,238 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstl/vector.h>
+#include "benchmark.h"
+#include "value_types.h"
+
+namespace sstl_bench
+{
+// internal linkage: the benchmark suites reuse the same helper names
+namespace
+{
+
+static const size_t CAPACITY = 1024;
+static const size_t INSERTIONS_PER_SAMPLE = 64;
+
+// std::vector with a preallocated buffer (no reallocations during the benchmarks)
+template<class T>
+class reserved_std_vector : public std::vector<T>
+{
+public:
+   reserved_std_vector()
+   {
+      this->reserve(CAPACITY);
+   }
+};
+
+template<class TVector>
+void fill(TVector& v, size_t count)
+{
+   v.clear();
+   for(size_t i=0; i<count; ++i)
+      v.push_back(make_value<typename TVector::value_type>(i));
+}
+
+template<class TVector>
+struct push_back_benchmark
+{
+   static const char* name() { return "push_back"; }
+
+   void operator()(sample_timer& timer)
+   {
+      v.clear();
+      auto value = make_value<typename TVector::value_type>(0);
+      timer.start();
+      for(size_t i=0; i<CAPACITY; ++i)
+         v.push_back(value);
+      timer.stop(CAPACITY);
+      do_not_optimize(v);
+   }
+
+   TVector v;
+};
+
+template<class TVector>
+struct emplace_back_benchmark
+{
+   static const char* name() { return "emplace_back"; }
+
+   void operator()(sample_timer& timer)
+   {
+      v.clear();
+      timer.start();
+      for(size_t i=0; i<CAPACITY; ++i)
+         v.emplace_back();
+      timer.stop(CAPACITY);
+      do_not_optimize(v);
+   }
+
+   TVector v;
+};
+
+template<class TVector>
+struct insert_front_benchmark
+{
+   static const char* name() { return "insert (front)"; }
+
+   void operator()(sample_timer& timer)
+   {
+      fill(v, CAPACITY/2);
+      auto value = make_value<typename TVector::value_type>(0);
+      timer.start();
+      for(size_t i=0; i<INSERTIONS_PER_SAMPLE; ++i)
+         v.insert(v.begin(), value);
+      timer.stop(INSERTIONS_PER_SAMPLE);
+      do_not_optimize(v);
+   }
+
+   TVector v;
+};
+
+template<class TVector>
+struct insert_middle_benchmark
+{
+   static const char* name() { return "insert (middle)"; }
+
+   void operator()(sample_timer& timer)
+   {
+      fill(v, CAPACITY/2);
+      auto value = make_value<typename TVector::value_type>(0);
+      timer.start();
+      for(size_t i=0; i<INSERTIONS_PER_SAMPLE; ++i)
+         v.insert(v.begin() + v.size()/2, value);
+      timer.stop(INSERTIONS_PER_SAMPLE);
+      do_not_optimize(v);
+   }
+
+   TVector v;
+};
+
+template<class TVector>
+struct erase_range_benchmark
+{
+   static const char* name() { return "erase (range of capacity/4)"; }
+
+   void operator()(sample_timer& timer)
+   {
+      fill(v, CAPACITY);
+      timer.start();
+      v.erase(v.begin() + CAPACITY/4, v.begin() + CAPACITY/2);
+      timer.stop();
+      do_not_optimize(v);
+   }
+
+   TVector v;
+};
+
+template<class TVector>
+struct swap_benchmark
+{
+   static const char* name() { return "swap (capacity <-> capacity/2)"; }
+
+   swap_benchmark()
+   {
+      fill(lhs, CAPACITY);
+      fill(rhs, CAPACITY/2);
+   }
+
+   void operator()(sample_timer& timer)
+   {
+      timer.start();
+      lhs.swap(rhs);
+      timer.stop();
+      do_not_optimize(lhs);
+      do_not_optimize(rhs);
+   }
+
+   TVector lhs;
+   TVector rhs;
+};
+
+template<class TVector>
+struct copy_assignment_benchmark
+{
+   static const char* name() { return "copy assignment"; }
+
+   copy_assignment_benchmark()
+   {
+      fill(src, CAPACITY);
+   }
+
+   void operator()(sample_timer& timer)
+   {
+      fill(dst, CAPACITY/2);
+      timer.start();
+      dst = src;
+      timer.stop();
+      do_not_optimize(dst);
+   }
+
+   TVector src;
+   TVector dst;
+};
+
+template<class TVector>
+struct move_assignment_benchmark
+{
+   static const char* name() { return "move assignment"; }
+
+   void operator()(sample_timer& timer)
+   {
+      fill(src, CAPACITY);
+      fill(dst, CAPACITY/2);
+      timer.start();
+      dst = std::move(src);
+      timer.stop();
+      do_not_optimize(dst);
+   }
+
+   TVector src;
+   TVector dst;
+};
+
+template<template<class> class TBenchmark, class TVector>
+void run(const std::string& container_name)
+{
+   // heap allocated, since the large sstl::vector instances might not fit on the stack
+   auto benchmark = std::unique_ptr<TBenchmark<TVector>>(new TBenchmark<TVector>());
+   auto name = container_name + "<" + value_name<typename TVector::value_type>() + "> " + TBenchmark<TVector>::name();
+   measure(name, [&benchmark](sample_timer& timer){ (*benchmark)(timer); });
+}
+
+template<template<class> class TBenchmark, class T>
+void compare()
+{
+   run<TBenchmark, sstl::vector<T, CAPACITY>>("sstl::vector");
+   run<TBenchmark, reserved_std_vector<T>>("std::vector");
+}
+
+template<class T>
+void compare_all()
+{
+   compare<push_back_benchmark, T>();
+   compare<emplace_back_benchmark, T>();
+   compare<insert_front_benchmark, T>();
+   compare<insert_middle_benchmark, T>();
+   compare<erase_range_benchmark, T>();
+   compare<swap_benchmark, T>();
+   compare<copy_assignment_benchmark, T>();
+   compare<move_assignment_benchmark, T>();
+}
+
+SSTL_BENCHMARK_SUITE("vector - sstl::vector vs reserved std::vector (capacity 1024)")
+{
+   compare_all<int>();
+   compare_all<pod64>();
+   compare_all<sstl_test::counted_type>();
+}
+
+}
+}
@@ -0,0 +1,264 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#ifndef _SSTL_BENCHMARK__
+#define _SSTL_BENCHMARK__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <sstl/__internal/_preprocessor.h>
+#include "cycle_clock.h"
+#include "histogram.h"
+
+#if _is_msvc()
+#include <intrin.h>
+#endif
+
+namespace sstl_bench
+{
+
+// prevents the compiler from optimizing away the computation of the given value
+template<class T>
+inline void do_not_optimize(const T& value)
+{
+   #if !_is_msvc()
+   asm volatile("" : : "r,m"(value) : "memory");
+   #else
+   static volatile const void* sink;
+   sink = static_cast<const void*>(&value);
+   #endif
+}
+
+// prevents the compiler from reordering or eliding the memory accesses around this point
+inline void clobber_memory()
+{
+   #if !_is_msvc()
+   asm volatile("" : : : "memory");
+   #else
+   _ReadWriteBarrier();
+   #endif
+}
+
+// measures the time spent within the start/stop pairs of a single sample
+class sample_timer
+{
+public:
+   void start()
+   {
+      clobber_memory();
+      _start = cycle_clock::start();
+   }
+
+   void stop(size_t operations=1)
+   {
+      auto now = cycle_clock::stop();
+      clobber_memory();
+      _elapsed += _subtract_overhead(now - _start);
+      _operations += operations;
+   }
+
+   double nanoseconds_per_operation() const
+   {
+      if(_operations == 0)
+         return 0.0;
+      return _elapsed * cycle_clock::nanoseconds_per_tick() / _operations;
+   }
+
+private:
+   static cycle_clock::ticks _subtract_overhead(cycle_clock::ticks elapsed)
+   {
+      return elapsed > cycle_clock::overhead() ? elapsed - cycle_clock::overhead() : 0;
+   }
+
+private:
+   cycle_clock::ticks _start{ 0 };
+   cycle_clock::ticks _elapsed{ 0 };
+   size_t _operations{ 0 };
+};
+
+// records the duration of each single start/stop pair into a histogram,
+// so that the tail of the distribution (up to the worst case) can be reported.
+// The (calibrated) overhead of reading the clock is subtracted from each sample.
+class operation_timer
+{
+public:
+   void start()
+   {
+      clobber_memory();
+      _start = cycle_clock::start();
+   }
+
+   void stop()
+   {
+      auto now = cycle_clock::stop();
+      clobber_memory();
+      auto elapsed = now - _start;
+      _ticks.record(elapsed > cycle_clock::overhead() ? elapsed - cycle_clock::overhead() : 0);
+   }
+
+   // the recorded durations, in cycle_clock ticks
+   const histogram& ticks() const
+   {
+      return _ticks;
+   }
+
+private:
+   cycle_clock::ticks _start{ 0 };
+   histogram _ticks;
+};
+
+struct statistics
+{
+   double min{ 0.0 };
+   double median{ 0.0 };
+   double p99{ 0.0 };
+   double p999{ 0.0 };
+   double p9999{ 0.0 };
+   double max{ 0.0 };
+};
+
+inline double percentile(const std::vector<double>& sorted_samples, double p)
+{
+   if(sorted_samples.empty())
+      return 0.0;
+   auto idx = static_cast<size_t>(p * (sorted_samples.size() - 1) + 0.5);
+   return sorted_samples[std::min(idx, sorted_samples.size() - 1)];
+}
+
+inline statistics compute_statistics(std::vector<double> samples)
+{
+   std::sort(samples.begin(), samples.end());
+   auto stats = statistics{};
+   if(!samples.empty())
+   {
+      stats.min = samples.front();
+      stats.median = percentile(samples, 0.5);
+      stats.p99 = percentile(samples, 0.99);
+      stats.p999 = percentile(samples, 0.999);
+      stats.p9999 = percentile(samples, 0.9999);
+      stats.max = samples.back();
+   }
+   return stats;
+}
+
+// computes the statistics (in nanoseconds) of a histogram of cycle_clock ticks
+inline statistics compute_statistics(const histogram& ticks)
+{
+   auto to_ns = [](histogram::value_type value){ return value * cycle_clock::nanoseconds_per_tick(); };
+   auto stats = statistics{};
+   stats.min = to_ns(ticks.min());
+   stats.median = to_ns(ticks.value_at_percentile(50.0));
+   stats.p99 = to_ns(ticks.value_at_percentile(99.0));
+   stats.p999 = to_ns(ticks.value_at_percentile(99.9));
+   stats.p9999 = to_ns(ticks.value_at_percentile(99.99));
+   stats.max = to_ns(ticks.max());
+   return stats;
+}
+
+struct configuration
+{
+   size_t samples{ 200 };
+   size_t warmup_samples{ 20 };
+};
+
+inline configuration& global_configuration()
+{
+   static configuration config;
+   return config;
+}
+
+inline void print_header(const std::string& suite)
+{
+   std::printf("\n%s\n", suite.c_str());
+   std::printf("%-64s %12s %12s %12s %12s %12s %12s\n",
+               "benchmark", "min ns/op", "median ns/op", "p99 ns/op", "p99.9 ns/op", "p99.99 ns/op", "max ns/op");
+}
+
+inline void print_result(const std::string& name, const statistics& stats)
+{
+   std::printf("%-64s %12.2f %12.2f %12.2f %12.2f %12.2f %12.2f\n",
+               name.c_str(), stats.min, stats.median, stats.p99, stats.p999, stats.p9999, stats.max);
+   std::fflush(stdout);
+}
+
+inline statistics report(const std::string& name, std::vector<double> samples)
+{
+   auto stats = compute_statistics(std::move(samples));
+   print_result(name, stats);
+   return stats;
+}
+
+inline statistics report(const std::string& name, const operation_timer& timer)
+{
+   auto stats = compute_statistics(timer.ticks());
+   print_result(name, stats);
+   return stats;
+}
+
+// Runs the specified body once per sample and reports the time per operation.
+// The body receives a sample_timer and is expected to surround the code to be
+// measured with start/stop, so that any setup/teardown is excluded from the results.
+template<class TBody>
+statistics measure(const std::string& name, TBody body)
+{
+   const auto& config = global_configuration();
+   for(size_t i=0; i<config.warmup_samples; ++i)
+   {
+      sample_timer timer;
+      body(timer);
+   }
+
+   auto samples = std::vector<double>{};
+   samples.reserve(config.samples);
+   for(size_t i=0; i<config.samples; ++i)
+   {
+      sample_timer timer;
+      body(timer);
+      samples.push_back(timer.nanoseconds_per_operation());
+   }
+
+   return report(name, std::move(samples));
+}
+
+struct suite
+{
+   const char* name;
+   void (*run)();
+};
+
+inline std::vector<suite>& registered_suites()
+{
+   static std::vector<suite> suites;
+   return suites;
+}
+
+struct suite_registrar
+{
+   suite_registrar(const char* name, void (*run)())
+   {
+      registered_suites().push_back(suite{ name, run });
+   }
+};
+
+}
+
+#define _sstl_bench_concat_impl(a, b) a##b
+#define _sstl_bench_concat(a, b) _sstl_bench_concat_impl(a, b)
+
+// defines a benchmark suite that gets registered and run by the benchmark's main
+#define SSTL_BENCHMARK_SUITE(name) \
+   static void _sstl_bench_concat(_sstl_bench_suite_, __LINE__)(); \
+   static sstl_bench::suite_registrar _sstl_bench_concat(_sstl_bench_registrar_, __LINE__)( \
+      name, &_sstl_bench_concat(_sstl_bench_suite_, __LINE__)); \
+   static void _sstl_bench_concat(_sstl_bench_suite_, __LINE__)()
+
+#endif
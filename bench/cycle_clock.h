@@ -0,0 +1,124 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#ifndef _SSTL_BENCHMARK_CYCLE_CLOCK__
+#define _SSTL_BENCHMARK_CYCLE_CLOCK__
+
+#include <cstdint>
+#include <chrono>
+#include <algorithm>
+#include <sstl/__internal/_preprocessor.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+   #define _sstl_bench_has_tsc() 1
+   #if _is_msvc()
+      #include <intrin.h>
+   #else
+      #include <x86intrin.h>
+   #endif
+#else
+   #define _sstl_bench_has_tsc() 0
+#endif
+
+namespace sstl_bench
+{
+
+// Reads the CPU's time-stamp counter with the serialization required to time
+// short code sequences, i.e. the instructions being measured can neither
+// be executed before start() nor after stop(). On architectures without
+// a time-stamp counter, falls back to std::chrono::steady_clock (1 tick = 1ns).
+class cycle_clock
+{
+public:
+   using ticks = std::uint64_t;
+
+   static ticks start()
+   {
+      #if _sstl_bench_has_tsc()
+      _mm_lfence(); // waits for the preceding instructions to complete
+      auto t = __rdtsc();
+      _mm_lfence(); // prevents the subsequent instructions from starting before the counter is read
+      return t;
+      #else
+      return _steady_clock_ticks();
+      #endif
+   }
+
+   static ticks stop()
+   {
+      #if _sstl_bench_has_tsc()
+      unsigned int aux;
+      auto t = __rdtscp(&aux); // waits for the preceding instructions to complete
+      _mm_lfence(); // prevents the subsequent instructions from starting before the counter is read
+      return t;
+      #else
+      return _steady_clock_ticks();
+      #endif
+   }
+
+   // minimum number of ticks measured between a start() and a stop() with nothing in between
+   static ticks overhead()
+   {
+      static const ticks value = _measure_overhead();
+      return value;
+   }
+
+   static double nanoseconds_per_tick()
+   {
+      static const double value = _measure_nanoseconds_per_tick();
+      return value;
+   }
+
+   static const char* name()
+   {
+      #if _sstl_bench_has_tsc()
+      return "rdtsc/rdtscp";
+      #else
+      return "steady_clock";
+      #endif
+   }
+
+private:
+   static ticks _steady_clock_ticks()
+   {
+      auto now = std::chrono::steady_clock::now().time_since_epoch();
+      return static_cast<ticks>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+   }
+
+   static ticks _measure_overhead()
+   {
+      auto overhead = static_cast<ticks>(-1);
+      for(size_t i=0; i<10000; ++i)
+      {
+         auto begin = start();
+         auto end = stop();
+         overhead = std::min(overhead, end - begin);
+      }
+      return overhead;
+   }
+
+   static double _measure_nanoseconds_per_tick()
+   {
+      #if _sstl_bench_has_tsc()
+      using clock = std::chrono::steady_clock;
+      const auto calibration_period = std::chrono::milliseconds(50);
+      auto clock_begin = clock::now();
+      auto ticks_begin = start();
+      while(clock::now() - clock_begin < calibration_period);
+      auto ticks_end = stop();
+      auto clock_end = clock::now();
+      auto elapsed_ns = std::chrono::duration<double, std::nano>(clock_end - clock_begin).count();
+      return elapsed_ns / static_cast<double>(ticks_end - ticks_begin);
+      #else
+      return 1.0;
+      #endif
+   }
+};
+
+}
+
+#endif
@@ -0,0 +1,118 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#ifndef _SSTL_BENCHMARK_HISTOGRAM__
+#define _SSTL_BENCHMARK_HISTOGRAM__
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <sstl/__internal/_preprocessor.h>
+
+namespace sstl_bench
+{
+
+// HDR-style (log-linear) histogram of non-negative integer values.
+// Values smaller than 2*SUB_BUCKETS are recorded exactly; larger values are
+// recorded with a relative error of at most 1/SUB_BUCKETS, regardless
+// of their magnitude. Recording is constant time and doesn't allocate memory.
+class histogram
+{
+public:
+   using value_type = std::uint64_t;
+
+   histogram()
+      : _counts(_NUMBER_OF_BUCKETS, 0)
+   {}
+
+   void record(value_type value)
+   {
+      ++_counts[_bucket_index(value)];
+      ++_count;
+      _min = std::min(_min, value);
+      _max = std::max(_max, value);
+   }
+
+   std::uint64_t count() const
+   {
+      return _count;
+   }
+
+   value_type min() const
+   {
+      return _count > 0 ? _min : 0;
+   }
+
+   value_type max() const
+   {
+      return _max;
+   }
+
+   // returns the smallest recorded value (with the histogram's precision) such that
+   // the specified percentage (0-100) of the recorded values is smaller or equal to it
+   value_type value_at_percentile(double percentile) const
+   {
+      if(_count == 0)
+         return 0;
+      auto target = static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * _count));
+      target = std::max<std::uint64_t>(target, 1);
+      std::uint64_t cumulated = 0;
+      for(size_t idx=0; idx<_counts.size(); ++idx)
+      {
+         cumulated += _counts[idx];
+         if(cumulated >= target)
+            return std::max(min(), std::min(_highest_equivalent_value(idx), _max));
+      }
+      return _max;
+   }
+
+private:
+   static const unsigned _SUB_BUCKET_BITS = 7;
+   static const value_type _SUB_BUCKETS = value_type(1) << _SUB_BUCKET_BITS;
+   static const size_t _NUMBER_OF_BUCKETS = (64 - _SUB_BUCKET_BITS + 1) * _SUB_BUCKETS;
+
+   static unsigned _most_significant_bit(value_type value)
+   {
+      #if _sstl_is_gcc()
+      return 63 - __builtin_clzll(value);
+      #else
+      unsigned msb = 0;
+      while(value >>= 1)
+         ++msb;
+      return msb;
+      #endif
+   }
+
+   static size_t _bucket_index(value_type value)
+   {
+      if(value < 2*_SUB_BUCKETS)
+         return static_cast<size_t>(value);
+      auto exponent = _most_significant_bit(value) - _SUB_BUCKET_BITS;
+      auto sub_bucket = (value >> exponent) - _SUB_BUCKETS;
+      return static_cast<size_t>((exponent + 1) * _SUB_BUCKETS + sub_bucket);
+   }
+
+   static value_type _highest_equivalent_value(size_t idx)
+   {
+      if(idx < 2*_SUB_BUCKETS)
+         return idx;
+      auto exponent = idx / _SUB_BUCKETS - 1;
+      auto mantissa = idx % _SUB_BUCKETS + _SUB_BUCKETS;
+      return ((mantissa + 1) << exponent) - 1;
+   }
+
+private:
+   std::vector<std::uint64_t> _counts;
+   std::uint64_t _count{ 0 };
+   value_type _min{ static_cast<value_type>(-1) };
+   value_type _max{ 0 };
+};
+
+}
+
+#endif
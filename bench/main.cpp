@@ -0,0 +1,54 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "benchmark.h"
+
+// usage: bench-sstl [--samples N] [suite-filter...]
+// only the suites whose name contains one of the specified filters are run
+int main(int argc, char* argv[])
+{
+   auto filters = std::vector<std::string>{};
+   for(int i=1; i<argc; ++i)
+   {
+      if(std::strcmp(argv[i], "--samples") == 0 && i+1 < argc)
+      {
+         auto samples = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+         sstl_bench::global_configuration().samples = samples > 0 ? samples : 1;
+         sstl_bench::global_configuration().warmup_samples = samples / 10;
+      }
+      else
+      {
+         filters.push_back(argv[i]);
+      }
+   }
+
+   std::printf("clock: %s, %.3f ns/tick, overhead %llu ticks\n",
+               sstl_bench::cycle_clock::name(),
+               sstl_bench::cycle_clock::nanoseconds_per_tick(),
+               static_cast<unsigned long long>(sstl_bench::cycle_clock::overhead()));
+
+   for(const auto& suite : sstl_bench::registered_suites())
+   {
+      auto selected = filters.empty();
+      for(const auto& filter : filters)
+      {
+         if(std::string{ suite.name }.find(filter) != std::string::npos)
+            selected = true;
+      }
+      if(selected)
+      {
+         sstl_bench::print_header(suite.name);
+         suite.run();
+      }
+   }
+
+   return EXIT_SUCCESS;
+}
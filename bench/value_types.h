@@ -0,0 +1,69 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#ifndef _SSTL_BENCHMARK_VALUE_TYPES__
+#define _SSTL_BENCHMARK_VALUE_TYPES__
+
+#include <cstddef>
+#include <cstdint>
+#include <counted_type.h>
+
+namespace sstl_bench
+{
+
+// trivially copyable type of the size of a typical cache line
+struct pod64
+{
+   std::uint64_t data[8];
+};
+
+template<class T>
+struct value_factory;
+
+template<>
+struct value_factory<int>
+{
+   static const char* name() { return "int"; }
+   static int make(size_t i) { return static_cast<int>(i); }
+};
+
+template<>
+struct value_factory<pod64>
+{
+   static const char* name() { return "pod64"; }
+   static pod64 make(size_t i)
+   {
+      auto value = pod64{};
+      for(auto& d : value.data)
+         d = i;
+      return value;
+   }
+};
+
+// non-trivial type (user-provided copy/move operations and destructor)
+template<>
+struct value_factory<sstl_test::counted_type>
+{
+   static const char* name() { return "counted_type"; }
+   static sstl_test::counted_type make(size_t i) { return sstl_test::counted_type(i); }
+};
+
+template<class T>
+T make_value(size_t i)
+{
+   return value_factory<T>::make(i);
+}
+
+template<class T>
+const char* value_name()
+{
+   return value_factory<T>::name();
+}
+
+}
+
+#endif
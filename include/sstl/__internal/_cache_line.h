@@ -0,0 +1,23 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#ifndef _SSTL_CACHE_LINE__
+#define _SSTL_CACHE_LINE__
+
+#include <cstddef>
+
+namespace sstl
+{
+
+//size of the cache lines by which the concurrent containers separate the member variables
+//written by different threads (false sharing). The containers pad the member variables
+//instead of aligning them, since (MSVC 2013) alignas isn't available
+static const size_t _cache_line_size = 64;
+
+}
+
+#endif
@@ -0,0 +1,181 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#ifndef _SSTL_DEQUE_LINEAR_ITERATOR__
+#define _SSTL_DEQUE_LINEAR_ITERATOR__
+
+#include <cstddef>
+#include <type_traits>
+#include <iterator>
+#include <sstl_assert.h>
+#include "_except.h"
+
+//wraps an offset (smaller than twice the capacity) around the storage of a deque:
+//with a power-of-two capacity by means of a bitmask, otherwise with a comparison
+template<size_t CAPACITY>
+size_t _wrap_deque_offset(size_t offset, std::true_type) _sstl_noexcept_
+{
+   return offset & (CAPACITY-1);
+}
+
+template<size_t CAPACITY>
+size_t _wrap_deque_offset(size_t offset, std::false_type) _sstl_noexcept_
+{
+   return offset >= CAPACITY ? offset-CAPACITY : offset;
+}
+
+template<size_t CAPACITY>
+size_t _wrap_deque_offset(size_t offset) _sstl_noexcept_
+{
+   return _wrap_deque_offset<CAPACITY>(offset, std::integral_constant<bool, (CAPACITY & (CAPACITY-1)) == 0>{});
+}
+
+//random access iterator of the sized deque that represents a position as the storage pointer plus
+//an unwrapped offset, i.e. the end isn't a sentinel value and the operations never look into the deque.
+//Stepping and comparing are plain integer operations and only the dereferencing wraps the offset around,
+//which lets the compiler optimize (and vectorize) the STL algorithms as if they iterated over an array
+template<class T, size_t CAPACITY>
+class _deque_linear_iterator
+{
+   friend _deque_linear_iterator<typename std::add_const<T>::type, CAPACITY>;
+   friend _deque_linear_iterator<typename std::remove_const<T>::type, CAPACITY>;
+
+public:
+   using iterator_category = std::random_access_iterator_tag;
+   using value_type = typename std::remove_const<T>::type;
+   using difference_type = ptrdiff_t;
+   using pointer = T*;
+   using reference = T&;
+
+public:
+   _deque_linear_iterator() = default;
+
+   _deque_linear_iterator(pointer storage, size_t offset) _sstl_noexcept_
+      : _storage(storage)
+      , _offset(offset)
+   {}
+
+   operator _deque_linear_iterator<typename std::add_const<T>::type, CAPACITY>() const _sstl_noexcept_
+   {
+      return _deque_linear_iterator<typename std::add_const<T>::type, CAPACITY>{ _storage, _offset };
+   }
+
+   reference operator*() const _sstl_noexcept_
+   {
+      return _storage[_wrap_deque_offset<CAPACITY>(_offset)];
+   }
+
+   pointer operator->() const _sstl_noexcept_
+   {
+      return &operator*();
+   }
+
+   _deque_linear_iterator& operator++() _sstl_noexcept_
+   {
+      ++_offset;
+      return *this;
+   }
+
+   _deque_linear_iterator operator++(int) _sstl_noexcept_
+   {
+      auto temp = *this;
+      ++_offset;
+      return temp;
+   }
+
+   _deque_linear_iterator& operator--() _sstl_noexcept_
+   {
+      --_offset;
+      return *this;
+   }
+
+   _deque_linear_iterator operator--(int) _sstl_noexcept_
+   {
+      auto temp = *this;
+      --_offset;
+      return temp;
+   }
+
+   _deque_linear_iterator& operator+=(difference_type inc) _sstl_noexcept_
+   {
+      _offset += inc;
+      return *this;
+   }
+
+   _deque_linear_iterator& operator-=(difference_type dec) _sstl_noexcept_
+   {
+      _offset -= dec;
+      return *this;
+   }
+
+   friend _deque_linear_iterator operator+(const _deque_linear_iterator& lhs, difference_type rhs) _sstl_noexcept_
+   {
+      return _deque_linear_iterator{ lhs._storage, lhs._offset + rhs };
+   }
+
+   friend _deque_linear_iterator operator+(difference_type lhs, const _deque_linear_iterator& rhs) _sstl_noexcept_
+   {
+      return rhs+lhs;
+   }
+
+   _deque_linear_iterator operator-(difference_type rhs) const _sstl_noexcept_
+   {
+      return _deque_linear_iterator{ _storage, _offset - rhs };
+   }
+
+   difference_type operator-(const _deque_linear_iterator<typename std::add_const<T>::type, CAPACITY>& rhs) const _sstl_noexcept_
+   {
+      sstl_assert(_storage == rhs._storage);
+      return static_cast<difference_type>(_offset - rhs._offset);
+   }
+
+   reference operator[](difference_type offset) const _sstl_noexcept_
+   {
+      return _storage[_wrap_deque_offset<CAPACITY>(_offset + offset)];
+   }
+
+   bool operator==(const _deque_linear_iterator<typename std::add_const<T>::type, CAPACITY>& rhs) const _sstl_noexcept_
+   {
+      sstl_assert(_storage == rhs._storage);
+      return _offset == rhs._offset;
+   }
+
+   bool operator!=(const _deque_linear_iterator<typename std::add_const<T>::type, CAPACITY>& rhs) const _sstl_noexcept_
+   {
+      return !operator==(rhs);
+   }
+
+   bool operator<(const _deque_linear_iterator<typename std::add_const<T>::type, CAPACITY>& rhs) const _sstl_noexcept_
+   {
+      sstl_assert(_storage == rhs._storage);
+      return _offset < rhs._offset;
+   }
+
+   bool operator>(const _deque_linear_iterator<typename std::add_const<T>::type, CAPACITY>& rhs) const _sstl_noexcept_
+   {
+      sstl_assert(_storage == rhs._storage);
+      return _offset > rhs._offset;
+   }
+
+   bool operator<=(const _deque_linear_iterator<typename std::add_const<T>::type, CAPACITY>& rhs) const _sstl_noexcept_
+   {
+      sstl_assert(_storage == rhs._storage);
+      return _offset <= rhs._offset;
+   }
+
+   bool operator>=(const _deque_linear_iterator<typename std::add_const<T>::type, CAPACITY>& rhs) const _sstl_noexcept_
+   {
+      sstl_assert(_storage == rhs._storage);
+      return _offset >= rhs._offset;
+   }
+
+private:
+   pointer _storage{ nullptr };
+   size_t _offset{ 0 }; //not wrapped, i.e. in [0, 2*CAPACITY]
+};
+
+#endif
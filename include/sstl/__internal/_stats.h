@@ -0,0 +1,117 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#ifndef _SSTL_STATS__
+#define _SSTL_STATS__
+
+#include <cstddef>
+#include <type_traits>
+#include <algorithm>
+
+//the containers and allocators collect usage statistics (e.g. to help sizing
+//their capacities) only if SSTL_ENABLE_STATS is defined. Otherwise the statistics
+//don't exist at all, i.e. they add neither member variables nor runtime overhead.
+#if defined(SSTL_ENABLE_STATS)
+   #define _sstl_has_stats() 1
+#else
+   #define _sstl_has_stats() 0
+#endif
+
+#if _sstl_has_stats()
+
+namespace sstl
+{
+
+struct container_stats
+{
+   size_t high_water_mark{ 0 }; //largest size ever reached
+   size_t operations{ 0 }; //number of modifying operations (construction, assignment, insertion, erasure, swap, ...)
+   size_t insertions{ 0 }; //number of elements by which the operations increased the size
+   size_t erasures{ 0 }; //number of elements by which the operations decreased the size
+   bool _is_recording{ false };
+};
+
+struct allocator_stats
+{
+   size_t allocated_blocks{ 0 }; //number of blocks currently allocated
+   size_t high_water_mark{ 0 }; //largest number of blocks ever allocated at once
+   size_t allocations{ 0 };
+   size_t deallocations{ 0 };
+};
+
+//records the size change caused by the modifying operation in whose scope it lives.
+//Operations implemented in terms of other modifying operations (e.g. swap in terms of
+//insert and erase) are recorded once, by the outermost recorder.
+template<class TContainer>
+class _container_stats_recorder
+{
+public:
+   _container_stats_recorder(const TContainer& container, container_stats& stats)
+      : _container(container)
+      , _stats(stats)
+      , _is_outermost(!stats._is_recording)
+      , _size_before(container.size())
+   {
+      _stats._is_recording = true;
+   }
+
+   _container_stats_recorder(const _container_stats_recorder&) = delete;
+   _container_stats_recorder& operator=(const _container_stats_recorder&) = delete;
+
+   ~_container_stats_recorder()
+   {
+      if(!_is_outermost)
+         return;
+      auto size_after = _container.size();
+      ++_stats.operations;
+      if(size_after > _size_before)
+         _stats.insertions += size_after - _size_before;
+      else
+         _stats.erasures += _size_before - size_after;
+      _stats.high_water_mark = std::max(_stats.high_water_mark, size_after);
+      _stats._is_recording = false;
+   }
+
+private:
+   const TContainer& _container;
+   container_stats& _stats;
+   bool _is_outermost;
+   size_t _size_before;
+};
+
+inline void _record_allocation(allocator_stats& stats)
+{
+   ++stats.allocations;
+   ++stats.allocated_blocks;
+   stats.high_water_mark = std::max(stats.high_water_mark, stats.allocated_blocks);
+}
+
+inline void _record_deallocation(allocator_stats& stats)
+{
+   ++stats.deallocations;
+   --stats.allocated_blocks;
+}
+
+}
+
+#define _sstl_stats_concat_impl(a, b) a##b
+#define _sstl_stats_concat(a, b) _sstl_stats_concat_impl(a, b)
+
+//records the modifying operation in whose scope it is placed. Requires the
+//container to declare a "_stats" member variable (see hacky derived class access).
+#define _sstl_record_container_stats(container_pointer) \
+   sstl::_container_stats_recorder<typename std::remove_pointer<decltype(container_pointer)>::type> \
+      _sstl_stats_concat(_sstl_stats_recorder_, __LINE__)( \
+         *(container_pointer), _sstl_member_of_derived_class(container_pointer, _stats))
+
+#else
+
+#define _sstl_record_container_stats(container_pointer)
+
+#endif
+
+#endif // _SSTL_STATS__
@@ -18,6 +18,7 @@ as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
 #include "__internal/_aligned_storage.h"
 #include "__internal/bitset_span.h"
 #include "__internal/_hacky_derived_class_access.h"
+#include "__internal/_stats.h"
 
 namespace sstl
 {
@@ -42,6 +43,9 @@ public:
       sstl_assert(!bitmap.all());
       auto free_block_idx = get_next_free_block_idx();
       bitmap.set(free_block_idx);
+      #if _sstl_has_stats()
+      _record_allocation(_sstl_member_of_derived_class(this, _stats));
+      #endif
       return &_sstl_member_of_derived_class(this, _pool)[free_block_idx];
    }
 
@@ -54,6 +58,9 @@ public:
       sstl_assert(bitmap.test(idx));
       bitmap.reset(idx);
       _sstl_member_of_derived_class(this, _last_allocated_block_idx) = idx - 1;
+      #if _sstl_has_stats()
+      _record_deallocation(_sstl_member_of_derived_class(this, _stats));
+      #endif
    }
 
    bool full() const _sstl_noexcept_
@@ -61,6 +68,13 @@ public:
       return _bitmap().all();
    }
 
+   #if _sstl_has_stats()
+   const allocator_stats& stats() const _sstl_noexcept_
+   {
+      return _sstl_member_of_derived_class(this, _stats);
+   }
+   #endif
+
 protected:
    using _type_for_hacky_derived_class_access = bitmap_allocator<T, 11>;
 
@@ -124,6 +138,9 @@ private:
    const size_type _capacity{ CAPACITY };
    size_type _last_allocated_block_idx{ static_cast<size_type>(-1) };
    pointer _pool{ static_cast<pointer>(static_cast<void*>(_pool_data)) };
+   #if _sstl_has_stats()
+   allocator_stats _stats;
+   #endif
    std::uint8_t _bitmap_data[(CAPACITY-1) / 8 + 1];
    typename _aligned_storage<sizeof(value_type), std::alignment_of<value_type>::value>::type _pool_data[CAPACITY];
 };
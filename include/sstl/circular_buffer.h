@@ -0,0 +1,107 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#ifndef _SSTL_CIRCULAR_BUFFER__
+#define _SSTL_CIRCULAR_BUFFER__
+
+#include <utility>
+#include "deque.h"
+
+namespace sstl
+{
+
+// deque that keeps the newest CAPACITY elements: push_back and emplace_back overwrite
+// the oldest element when the buffer is full (see deque::push_back_overwrite).
+// The deque is a private base class, so that the operations that would insert into a full
+// buffer (push_front, insert, emplace, ...) aren't reachable. The other operations are the deque's ones
+template<class T, size_t CAPACITY>
+class circular_buffer : private deque<T, CAPACITY>
+{
+private:
+   using _base = deque<T, CAPACITY>;
+
+public:
+   using value_type = typename _base::value_type;
+   using size_type = typename _base::size_type;
+   using difference_type = typename _base::difference_type;
+   using reference = typename _base::reference;
+   using const_reference = typename _base::const_reference;
+   using pointer = typename _base::pointer;
+   using const_pointer = typename _base::const_pointer;
+   using iterator = typename _base::iterator;
+   using const_iterator = typename _base::const_iterator;
+   using reverse_iterator = typename _base::reverse_iterator;
+   using const_reverse_iterator = typename _base::const_reverse_iterator;
+   using linear_iterator = typename _base::linear_iterator;
+   using const_linear_iterator = typename _base::const_linear_iterator;
+
+public:
+   circular_buffer() _sstl_noexcept_ = default;
+
+   using _base::at;
+   using _base::operator[];
+   using _base::front;
+   using _base::back;
+
+   using _base::begin;
+   using _base::cbegin;
+   using _base::end;
+   using _base::cend;
+   using _base::rbegin;
+   using _base::crbegin;
+   using _base::rend;
+   using _base::crend;
+   using _base::linear_begin;
+   using _base::linear_cbegin;
+   using _base::linear_end;
+   using _base::linear_cend;
+
+   using _base::empty;
+   using _base::full;
+   using _base::size;
+   using _base::max_size;
+   using _base::capacity;
+
+   using _base::as_spans;
+   using _base::for_each_segment;
+   using _base::snapshot;
+
+   using _base::clear;
+   using _base::erase;
+   using _base::pop_front;
+   using _base::pop_back;
+   using _base::pop_front_n;
+   using _base::pop_back_n;
+
+   #if _sstl_has_stats()
+   using _base::stats;
+   using _base::reset_stats;
+   #endif
+
+   void push_back(const_reference value)
+      _sstl_noexcept(noexcept(std::declval<_base>().push_back_overwrite(std::declval<const_reference>())))
+   {
+      _base::push_back_overwrite(value);
+   }
+
+   void push_back(value_type&& value)
+      _sstl_noexcept(noexcept(std::declval<_base>().push_back_overwrite(std::declval<value_type&&>())))
+   {
+      _base::push_back_overwrite(std::move(value));
+   }
+
+   template<class... Args>
+   void emplace_back(Args&&... args)
+      _sstl_noexcept(noexcept(std::declval<_base>().emplace_back_overwrite(std::declval<Args>()...)))
+   {
+      _base::emplace_back_overwrite(std::forward<Args>(args)...);
+   }
+};
+
+}
+
+#endif
@@ -15,14 +15,18 @@ as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
 #include <iterator>
 #include <initializer_list>
 #include <array>
+#include <cstring>
 
 #include <sstl_assert.h>
 
 #include "__internal/_aligned_storage.h"
 #include "__internal/_iterator.h"
 #include "__internal/_deque_iterator.h"
+#include "__internal/_deque_linear_iterator.h"
 #include "__internal/_hacky_derived_class_access.h"
 #include "__internal/_debug.h"
+#include "__internal/_stats.h"
+#include "type_traits.h"
 
 namespace sstl
 {
@@ -55,11 +59,22 @@ public:
    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
    using difference_type = typename iterator::difference_type;
 
+   //contiguous run of positions of the internal storage
+   template<class TPointer>
+   struct basic_segment
+   {
+      TPointer data;
+      size_type size;
+   };
+   using segment = basic_segment<pointer>;
+   using const_segment = basic_segment<const_pointer>;
+
 public:
    deque& operator=(const deque& rhs)
       _sstl_noexcept(std::is_nothrow_copy_assignable<value_type>::value
                      && std::is_nothrow_copy_constructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       if(this == &rhs)
          return *this;
 
@@ -73,6 +88,8 @@ public:
       _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value
                      && std::is_nothrow_move_constructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
+      _sstl_record_container_stats(&rhs);
       sstl_assert(rhs.size() <= capacity());
       auto move_assignments = std::min(size(), rhs.size());
       auto move_constructions = rhs.size() - move_assignments;
@@ -154,6 +171,7 @@ public:
          std::declval<std::initializer_list<value_type>>().begin(),
          std::declval<std::initializer_list<value_type>>().end())))
    {
+      _sstl_record_container_stats(this);
       _range_assignment(ilist.begin(), ilist.end());
       return *this;
    }
@@ -162,6 +180,7 @@ public:
       _sstl_noexcept(std::is_nothrow_copy_assignable<value_type>::value
                      && std::is_nothrow_copy_constructible<value_type>())
    {
+      _sstl_record_container_stats(this);
       sstl_assert(count <= capacity());
       auto dst = _sstl_member_of_derived_class(this, _first_pointer);
 
@@ -344,8 +363,76 @@ public:
       return _sstl_member_of_derived_class(this, _end_storage) - _begin_storage();
    }
 
+   //returns the (at most two) contiguous segments of the storage holding the elements, in order.
+   //The second segment is empty unless the elements wrap around the end of the storage
+   std::array<segment, 2> as_spans() _sstl_noexcept_
+   {
+      return _segments(_sstl_member_of_derived_class(this, _first_pointer), size());
+   }
+
+   std::array<const_segment, 2> as_spans() const _sstl_noexcept_
+   {
+      auto segments = const_cast<deque&>(*this).as_spans();
+      return {{ const_segment{ segments[0].data, segments[0].size },
+                const_segment{ segments[1].data, segments[1].size } }};
+   }
+
+   //returns the (at most two) contiguous segments of uninitialized storage that follow the last
+   //element, in the order in which push_back would fill them. See commit
+   std::array<segment, 2> free_spans() _sstl_noexcept_
+   {
+      return _segments(_inc_pointer(_sstl_member_of_derived_class(this, _last_pointer)), capacity() - size());
+   }
+
+   //calls the specified function with the data pointer and the size of each non-empty segment
+   //holding elements (see as_spans)
+   template<class TFunction>
+   void for_each_segment(TFunction function)
+   {
+      for(const auto& crt : as_spans())
+         if(crt.size > 0)
+            function(crt.data, crt.size);
+   }
+
+   template<class TFunction>
+   void for_each_segment(TFunction function) const
+   {
+      for(const auto& crt : as_spans())
+         if(crt.size > 0)
+            function(crt.data, crt.size);
+   }
+
+   //copies the elements, in order, to the output range with (at most) two copies, one per segment
+   template<class TOutputIterator>
+   TOutputIterator snapshot(TOutputIterator out) const
+   {
+      for(const auto& crt : as_spans())
+         out = std::copy(crt.data, crt.data + crt.size, out);
+      return out;
+   }
+
+   //same as above, for the segments of uninitialized storage (see free_spans)
+   template<class TFunction>
+   void for_each_free_segment(TFunction function)
+   {
+      for(const auto& crt : free_spans())
+         if(crt.size > 0)
+            function(crt.data, crt.size);
+   }
+
+   //appends the count elements constructed by the caller into the segments returned by free_spans
+   void commit(size_type count) _sstl_noexcept_
+   {
+      _sstl_record_container_stats(this);
+      sstl_assert(size() + count <= capacity());
+      _sstl_member_of_derived_class(this, _last_pointer) =
+         _add_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), count);
+      _sstl_member_of_derived_class(this, _size) += count;
+   }
+
    void clear() _sstl_noexcept(std::is_nothrow_destructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       while (_sstl_member_of_derived_class(this, _size) > 0)
       {
          _sstl_member_of_derived_class(this, _last_pointer)->~value_type();
@@ -358,6 +445,7 @@ public:
       _sstl_noexcept(noexcept(std::declval<deque>()._emplace_value(std::declval<const_iterator>(),
                                                                      std::declval<const value_type&>())))
    {
+      _sstl_record_container_stats(this);
       return _emplace_value(pos, value);
    }
 
@@ -365,6 +453,7 @@ public:
       _sstl_noexcept(noexcept(std::declval<deque>()._emplace_value(std::declval<const_iterator>(),
                                                                      std::declval<value_type&&>())))
    {
+      _sstl_record_container_stats(this);
       return _emplace_value(pos, std::move(value));
    }
 
@@ -377,92 +466,12 @@ public:
          && std::is_nothrow_copy_constructible<value_type>::value
          && std::is_nothrow_copy_assignable<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       if(count==0)
          return iterator{ this, const_cast<pointer>(pos._pos) };
 
       sstl_assert(size()+count <= capacity());
-      auto distance_to_begin = static_cast<size_type>(std::distance(cbegin(), pos));
-      auto distance_to_end = static_cast<size_type>(std::distance(pos, cend()));
-
-      if(distance_to_begin < distance_to_end)
-      {
-         auto new_region_first_pointer = _shift_from_begin_to_pos_by_n_positions(count, distance_to_begin);
-         auto dst = new_region_first_pointer;
-         auto number_of_constructions = count > distance_to_begin ? count-distance_to_begin : 0;
-         size_type remaining_constructions;
-         #if _sstl_has_exceptions()
-         try
-         {
-         #endif
-            for(remaining_constructions=number_of_constructions; remaining_constructions>0; --remaining_constructions)
-            {
-               new(dst) value_type(value);
-               dst = _inc_pointer(dst);
-            }
-         #if _sstl_has_exceptions()
-         }
-         catch(...)
-         {
-            auto crt = _sstl_member_of_derived_class(this, _first_pointer);
-            while(crt != dst)
-            {
-               crt->~value_type();
-               crt = _inc_pointer(crt);
-            }
-            for(size_t i=0; i<remaining_constructions; ++i)
-            {
-               crt = _inc_pointer(crt);
-            }
-            _sstl_member_of_derived_class(this, _first_pointer) = crt;
-            _sstl_member_of_derived_class(this, _size) -= count;
-            throw;
-         }
-         #endif
-         auto number_of_assignments = count-number_of_constructions;
-         for(size_type i=number_of_assignments; i>0; --i)
-         {
-            *dst = value;
-            dst = _inc_pointer(dst);
-         }
-         return iterator{ this, new_region_first_pointer };
-      }
-      else
-      {
-         auto new_region_last_pointer = _shift_from_pos_to_end_by_n_positions(count, distance_to_end);
-         auto dst = new_region_last_pointer;
-         auto number_of_constructions = count > distance_to_end ? count-distance_to_end : 0;
-         #if _sstl_has_exceptions()
-         try
-         {
-         #endif
-            for(size_type i=number_of_constructions; i>0; --i)
-            {
-               new(dst) value_type(value);
-               dst = _dec_pointer(dst);
-            }
-         #if _sstl_has_exceptions()
-         }
-         catch(...)
-         {
-            while (dst != _sstl_member_of_derived_class(this, _last_pointer))
-            {
-               dst = _inc_pointer(dst);
-               dst->~value_type();
-            }
-            _sstl_member_of_derived_class(this, _last_pointer) =
-               _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), count);
-            _sstl_member_of_derived_class(this, _size) -= count;
-            throw;
-         }
-         #endif
-         auto number_of_assignments = count - number_of_constructions;
-         for(size_type i=number_of_assignments; i>0; --i)
-         {
-            *dst = value;
-            dst = _dec_pointer(dst);
-         }
-         return iterator{ this, _inc_pointer(dst) };
-      }
+      return _insert_n(pos, count, value, _is_trivially_relocatable{});
    }
 
    template<class TIterator>
@@ -477,6 +486,7 @@ public:
                                           std::declval<iterator>(),
                                           std::declval<iterator>())))
    {
+      _sstl_record_container_stats(this);
       auto old_size = size();
       auto distance_to_begin = std::distance(cbegin(), pos);
       auto distance_to_end = std::distance(pos, cend());
@@ -510,218 +520,31 @@ public:
          && std::is_nothrow_copy_constructible<value_type>::value
          && std::is_nothrow_copy_assignable<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       auto count = static_cast<size_type>(std::distance(range_begin, range_end));
       if(count==0)
          return iterator{ this, const_cast<pointer>(pos._pos) };
 
       sstl_assert(size()+count <= capacity());
-      auto distance_to_begin = static_cast<size_type>(std::distance(cbegin(), pos));
-      auto distance_to_end = static_cast<size_type>(std::distance(pos, cend()));
-      auto range_pos = range_begin;
-
-      if(distance_to_begin < distance_to_end)
-      {
-         auto new_region_first_pointer = _shift_from_begin_to_pos_by_n_positions(count, distance_to_begin);
-         auto dst = new_region_first_pointer;
-         auto number_of_constructions = count > distance_to_begin ? count-distance_to_begin : 0;
-         size_type remaining_constructions;
-         #if _sstl_has_exceptions()
-         try
-         {
-         #endif
-            for(remaining_constructions=number_of_constructions; remaining_constructions>0; --remaining_constructions)
-            {
-               new(dst) value_type(*range_pos);
-               ++range_pos;
-               dst = _inc_pointer(dst);
-            }
-         #if _sstl_has_exceptions()
-         }
-         catch(...)
-         {
-            auto crt = _sstl_member_of_derived_class(this, _first_pointer);
-            while(crt != dst)
-            {
-               crt->~value_type();
-               crt = _inc_pointer(crt);
-            }
-            for(size_t i=0; i<remaining_constructions; ++i)
-            {
-               crt = _inc_pointer(crt);
-            }
-            _sstl_member_of_derived_class(this, _first_pointer) = crt;
-            _sstl_member_of_derived_class(this, _size) -= count;
-            throw;
-         }
-         #endif
-         auto number_of_assignments = count-number_of_constructions;
-         for(size_type i=number_of_assignments; i>0; --i)
-         {
-            *dst = *range_pos;
-            ++range_pos;
-            dst = _inc_pointer(dst);
-         }
-         return iterator{ this, new_region_first_pointer };
-      }
-      else
-      {
-         auto new_region_last_pointer = _shift_from_pos_to_end_by_n_positions(count, distance_to_end);
-         auto new_region_first_pointer = _subtract_offset_to_pointer(new_region_last_pointer, count > 0 ? count-1 : 0);
-         auto dst = new_region_first_pointer;
-         auto number_of_constructions = count > distance_to_end ? count-distance_to_end : 0;
-         auto number_of_assignments = count - number_of_constructions;
-
-         size_type remaining_assignments = number_of_assignments;
-         size_type remaining_constructions = number_of_constructions;
-         #if _sstl_has_exceptions()
-         try
-         {
-         #endif
-            while(remaining_assignments > 0)
-            {
-               *dst = *range_pos;
-               ++range_pos;
-               dst = _inc_pointer(dst);
-               --remaining_assignments;
-            }
-            while(remaining_constructions > 0)
-            {
-               new(dst) value_type(*range_pos);
-               ++range_pos;
-               dst = _inc_pointer(dst);
-               --remaining_constructions;
-            }
-         #if _sstl_has_exceptions()
-         }
-         catch(...)
-         {
-            for(size_type i=0; i<remaining_assignments; ++i)
-            {
-               dst = _inc_pointer(dst);
-            }
-            for(size_type i=0; i<remaining_constructions; ++i)
-            {
-               dst = _inc_pointer(dst);
-            }
-            for(size_type i=0; i<distance_to_end; ++i)
-            {
-               dst->~value_type();
-               dst = _inc_pointer(dst);
-            }
-            auto constructions_done = number_of_constructions-remaining_constructions;
-            _sstl_member_of_derived_class(this, _last_pointer) =
-               _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), count - constructions_done);
-            _sstl_member_of_derived_class(this, _size) -= (count - constructions_done);
-            throw;
-         }
-         #endif
-         return iterator{ this, new_region_first_pointer };
-      }
+      return _insert_range(pos, range_begin, count, _is_trivially_relocatable{});
    }
 
    iterator erase(const_iterator pos)
-      _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value)
+      _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value && std::is_nothrow_destructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       sstl_assert(!empty());
       sstl_assert(pos != cend());
-      auto distance_to_begin = static_cast<size_type>(pos - cbegin());
-      auto distance_to_end = static_cast<size_type>(cend() - pos);
-      auto pos_pointer = const_cast<pointer>(pos._pos);
-      if(distance_to_begin < distance_to_end)
-      {
-         auto src = _dec_pointer(pos_pointer);
-         auto dst = pos_pointer;
-         while (dst != _sstl_member_of_derived_class(this, _first_pointer))
-         {
-            *dst = std::move(*src);
-            dst = src;
-            src = _dec_pointer(src);
-         }
-         _sstl_member_of_derived_class(this, _first_pointer)->~value_type();
-         _sstl_member_of_derived_class(this, _first_pointer) = _inc_pointer(_sstl_member_of_derived_class(this, _first_pointer));
-         --_sstl_member_of_derived_class(this, _size);
-         return iterator{ this, _inc_pointer(pos_pointer) };
-      }
-      else
-      {
-         auto src = _inc_pointer(pos_pointer);
-         auto dst = pos_pointer;
-         while (dst != _sstl_member_of_derived_class(this, _last_pointer))
-         {
-            *dst = std::move(*src);
-            dst = src;
-            src = _inc_pointer(src);
-         }
-         auto pos_pointer_to_return =  pos_pointer != _sstl_member_of_derived_class(this, _last_pointer)
-                                       ? pos_pointer : nullptr;
-         _sstl_member_of_derived_class(this, _last_pointer)->~value_type();
-         _sstl_member_of_derived_class(this, _last_pointer) = _dec_pointer(_sstl_member_of_derived_class(this, _last_pointer));
-         --_sstl_member_of_derived_class(this, _size);
-         return iterator{ this, pos_pointer_to_return };
-      }
+      return _erase(pos, _is_trivially_relocatable{});
    }
 
    iterator erase(const_iterator range_begin, const_iterator range_end)
-      _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value)
+      _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value && std::is_nothrow_destructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       if(range_begin == range_end)
          return iterator{ this, const_cast<pointer>(range_begin._pos) };
-      
-      auto distance_to_begin = static_cast<size_type>(range_begin - cbegin());
-      auto distance_to_end = static_cast<size_type>(cend() - range_end);
-      auto range_size = range_end - range_begin;
-      if(distance_to_begin < distance_to_end)
-      {
-         auto src = const_cast<pointer>(range_begin._pos);
-         auto dst = (range_end != cend())
-                  ? const_cast<pointer>(_dec_pointer(range_end._pos))
-                  : _sstl_member_of_derived_class(this, _last_pointer);
-         while (src != _sstl_member_of_derived_class(this, _first_pointer))
-         {
-            src = _dec_pointer(src);
-            *dst = std::move(*src);
-            dst = _dec_pointer(dst);
-         }
-         auto new_first_pointer = _inc_pointer(dst);
-         while(true)
-         {
-            dst->~value_type();
-            if (dst == _sstl_member_of_derived_class(this, _first_pointer))
-               break;
-            dst = _dec_pointer(dst);
-         };
-         _sstl_member_of_derived_class(this, _first_pointer) = new_first_pointer;
-         _sstl_member_of_derived_class(this, _size) -= range_size;
-         return iterator{ this, const_cast<pointer>(range_end._pos) };
-      }
-      else
-      {
-         auto src = (range_end != cend())
-                  ? const_cast<pointer>(_dec_pointer(range_end._pos))
-                  : _sstl_member_of_derived_class(this, _last_pointer);
-         auto dst = const_cast<pointer>(range_begin._pos);
-         while (src != _sstl_member_of_derived_class(this, _last_pointer))
-         {
-            src = _inc_pointer(src);
-            *dst = std::move(*src);
-            dst = _inc_pointer(dst);
-         }
-         auto new_last_pointer = _dec_pointer(dst);
-         while(true)
-         {
-            dst->~value_type();
-            if (dst == _sstl_member_of_derived_class(this, _last_pointer))
-               break;
-            dst = _inc_pointer(dst);
-         }
-         pointer return_pos = (range_end._pos != nullptr)
-                           ? const_cast<pointer>(range_begin._pos)
-                           : nullptr;
-         _sstl_member_of_derived_class(this, _last_pointer) = new_last_pointer;
-         _sstl_member_of_derived_class(this, _size) -= range_size;
-         return iterator{ this, return_pos };
-      }
-      
+      return _erase(range_begin, range_end, _is_trivially_relocatable{});
    }
 
    template<class... Args>
@@ -729,6 +552,7 @@ public:
       _sstl_noexcept(noexcept(std::declval<deque>()._emplace_value(std::declval<const_iterator>(),
                                                                      std::declval<value_type&&>())))
    {
+      _sstl_record_container_stats(this);
       value_type value(std::forward<Args>(args)...);
       return _emplace_value(pos, std::move(value));
    }
@@ -749,6 +573,7 @@ public:
    void emplace_front(Args&&... value)
       _sstl_noexcept(std::is_nothrow_constructible<value_type, typename std::add_rvalue_reference<Args>::type...>::value)
    {
+      _sstl_record_container_stats(this);
       sstl_assert(!full());
       pointer new_first_pointer;
       if(!empty())
@@ -780,6 +605,7 @@ public:
    void emplace_back(Args&&... args)
       _sstl_noexcept(std::is_nothrow_constructible<value_type, typename std::add_rvalue_reference<Args>::type...>::value)
    {
+      _sstl_record_container_stats(this);
       sstl_assert(!full());
       auto new_last_pointer = _inc_pointer(_sstl_member_of_derived_class(this, _last_pointer));
       new(new_last_pointer) value_type(std::forward<Args>(args)...);
@@ -789,6 +615,7 @@ public:
 
    void pop_back() _sstl_noexcept_
    {
+      _sstl_record_container_stats(this);
       sstl_assert(!empty());
       _sstl_member_of_derived_class(this, _last_pointer)->~value_type();
       _sstl_member_of_derived_class(this, _last_pointer) = _dec_pointer(_sstl_member_of_derived_class(this, _last_pointer));
@@ -798,16 +625,69 @@ public:
    void pop_front()
       _sstl_noexcept(std::is_nothrow_destructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       sstl_assert(!empty());
       _sstl_member_of_derived_class(this, _first_pointer)->~value_type();
       _sstl_member_of_derived_class(this, _first_pointer) = _inc_pointer(_sstl_member_of_derived_class(this, _first_pointer));
       --_sstl_member_of_derived_class(this, _size);
    }
 
+   //the batched operations below copy/move the elements of trivially copyable types with
+   //at most two memcpys (one per segment, see as_spans/free_spans) and update the state once
+   template<class TIterator>
+   void push_back_n(TIterator range_begin, size_type count)
+      _sstl_noexcept(noexcept(value_type(*std::declval<TIterator&>())))
+   {
+      _sstl_record_container_stats(this);
+      sstl_assert(size() + count <= capacity());
+      _push_back_n(range_begin, count, _is_trivially_copyable_range<TIterator>{});
+   }
+
+   template<class... Args>
+   void emplace_back_n(size_type count, const Args&... args)
+      _sstl_noexcept(std::is_nothrow_constructible<value_type, const Args&...>::value)
+   {
+      _sstl_record_container_stats(this);
+      sstl_assert(size() + count <= capacity());
+      _construct_back_n(count, [&](pointer dst){ new(dst) value_type(args...); });
+   }
+
+   //moves the first count elements to the output range and removes them
+   template<class TOutputIterator>
+   TOutputIterator pop_front_n(TOutputIterator out, size_type count)
+      _sstl_noexcept(noexcept(*std::declval<TOutputIterator&>() = std::declval<value_type&&>())
+                     && std::is_nothrow_destructible<value_type>::value)
+   {
+      _sstl_record_container_stats(this);
+      sstl_assert(count <= size());
+      return _pop_front_n(out, count, _is_trivially_copyable_output<TOutputIterator>{});
+   }
+
+   void pop_back_n(size_type count)
+      _sstl_noexcept(std::is_nothrow_destructible<value_type>::value)
+   {
+      _sstl_record_container_stats(this);
+      sstl_assert(count <= size());
+      if(!std::is_trivially_destructible<value_type>::value)
+      {
+         auto crt = _sstl_member_of_derived_class(this, _last_pointer);
+         for(size_type i=count; i>0; --i)
+         {
+            crt->~value_type();
+            crt = _dec_pointer(crt);
+         }
+      }
+      _sstl_member_of_derived_class(this, _last_pointer) =
+         _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), count);
+      _sstl_member_of_derived_class(this, _size) -= count;
+   }
+
    void swap(deque& rhs)
       _sstl_noexcept(std::is_nothrow_move_constructible<value_type>::value
                   && std::is_nothrow_move_assignable<value_type>::value)
    {
+      _sstl_record_container_stats(this);
+      _sstl_record_container_stats(&rhs);
       if(size() < rhs.size())
       {
          auto pos = std::swap_ranges(begin(), end(), rhs.begin());
@@ -822,6 +702,37 @@ public:
       }
    }
 
+   #if _sstl_has_stats()
+   const container_stats& stats() const _sstl_noexcept_
+   {
+      return _sstl_member_of_derived_class(this, _stats);
+   }
+
+   void reset_stats() _sstl_noexcept_
+   {
+      _sstl_member_of_derived_class(this, _stats) = container_stats{};
+      _sstl_member_of_derived_class(this, _stats).high_water_mark = size();
+   }
+   #endif
+
+protected:
+   //trivially relocatable elements are shifted with raw memory moves, see sstl::is_trivially_relocatable
+   using _is_trivially_relocatable = sstl::is_trivially_relocatable<value_type>;
+
+   //a range of trivially copyable elements can be copied in bulk if it is a contiguous array of value_type
+   template<class TIterator>
+   struct _is_trivially_copyable_range : std::integral_constant<bool,
+         std::is_trivially_copyable<value_type>::value
+         && std::is_pointer<TIterator>::value
+         && std::is_same<typename std::remove_cv<typename std::remove_pointer<TIterator>::type>::type, value_type>::value>
+   {};
+
+   template<class TIterator>
+   struct _is_trivially_copyable_output : std::integral_constant<bool,
+         std::is_trivially_copyable<value_type>::value
+         && std::is_same<TIterator, pointer>::value>
+   {};
+
 protected:
    deque() _sstl_noexcept_ = default;
    deque(const deque&) _sstl_noexcept_ = default;
@@ -831,6 +742,7 @@ protected:
    void _count_constructor(size_type count, const_reference value)
       _sstl_noexcept(std::is_nothrow_copy_constructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       sstl_assert(count <= capacity());
       auto pos = _sstl_member_of_derived_class(this, _first_pointer);
       auto last_pos = pos+count;
@@ -861,6 +773,7 @@ protected:
    void _range_constructor(TIterator range_begin, TIterator range_end)
       _sstl_noexcept(std::is_nothrow_copy_constructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       auto src = range_begin;
       auto dst = _begin_storage()-1;
       #if _sstl_has_exceptions()
@@ -889,6 +802,8 @@ protected:
    void _move_constructor(deque&& rhs)
       _sstl_noexcept(std::is_nothrow_move_constructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
+      _sstl_record_container_stats(&rhs);
       sstl_assert(rhs.size() <= capacity());
       auto src = _sstl_member_of_derived_class(&rhs, _first_pointer);
       auto dst = _begin_storage();
@@ -981,180 +896,817 @@ protected:
       _sstl_member_of_derived_class(this, _size) = new_size;
    }
 
-   template<class TValue>
-   iterator _emplace_value(const_iterator pos, TValue&& value)
-      _sstl_noexcept(std::is_nothrow_move_constructible<value_type>()
-                  && std::is_nothrow_move_assignable<value_type>())
+   // std::true_type -> trivially relocatable value type
+   iterator _insert_n(const_iterator pos, size_type count, const_reference value, std::true_type)
+      _sstl_noexcept(std::is_nothrow_copy_constructible<value_type>::value)
    {
-      sstl_assert(!full());
-      auto distance_to_begin = std::distance(cbegin(), pos);
-      auto distance_to_end = std::distance(pos, cend());
-      if(distance_to_begin < distance_to_end)
+      if(_is_in_storage(std::addressof(value))) //the value is an element that might get relocated
       {
-         auto src = _sstl_member_of_derived_class(this, _first_pointer);
-         auto dst = _dec_pointer(_sstl_member_of_derived_class(this, _first_pointer));
-         auto dst_end = _add_offset_to_pointer(dst, distance_to_begin);
-
-         if(distance_to_begin > 0)
-         {
-            new(dst) value_type(std::move(*src));
-            _sstl_member_of_derived_class(this, _first_pointer) = dst;
-            ++_sstl_member_of_derived_class(this, _size);
+         value_type copy(value);
+         return _insert_by_relocation(pos, count, [&copy](pointer dst){ new(dst) value_type(copy); });
+      }
+      return _insert_by_relocation(pos, count, [&value](pointer dst){ new(dst) value_type(value); });
+   }
 
-            src = _inc_pointer(src);
-            dst = _inc_pointer(dst);
+   // std::false_type -> the elements on the shorter side of pos are shifted by move constructions and assignments
+   iterator _insert_n(const_iterator pos, size_type count, const_reference value, std::false_type)
+      _sstl_noexcept(
+            noexcept(std::declval<deque>()._shift_from_begin_to_pos_by_n_positions(  std::declval<size_type>(),
+                                                                                       std::declval<difference_type>()))
+         && noexcept(std::declval<deque>()._shift_from_pos_to_end_by_n_positions( std::declval<size_type>(),
+                                                                                    std::declval<difference_type>()))
+         && std::is_nothrow_copy_constructible<value_type>::value
+         && std::is_nothrow_copy_assignable<value_type>::value)
+   {
+      auto distance_to_begin = static_cast<size_type>(std::distance(cbegin(), pos));
+      auto distance_to_end = static_cast<size_type>(std::distance(pos, cend()));
 
-            while(dst != dst_end)
+      if(distance_to_begin < distance_to_end)
+      {
+         auto new_region_first_pointer = _shift_from_begin_to_pos_by_n_positions(count, distance_to_begin);
+         auto dst = new_region_first_pointer;
+         auto number_of_constructions = count > distance_to_begin ? count-distance_to_begin : 0;
+         size_type remaining_constructions;
+         #if _sstl_has_exceptions()
+         try
+         {
+         #endif
+            for(remaining_constructions=number_of_constructions; remaining_constructions>0; --remaining_constructions)
             {
-               *dst = std::move(*src);
-               src = _inc_pointer(src);
+               new(dst) value_type(value);
                dst = _inc_pointer(dst);
             }
-            *dst_end = std::forward<TValue>(value);
+         #if _sstl_has_exceptions()
          }
-         else
+         catch(...)
          {
-            new(dst_end) value_type(std::forward<TValue>(value));
-            _sstl_member_of_derived_class(this, _first_pointer) = dst;
-            ++_sstl_member_of_derived_class(this, _size);
+            auto crt = _sstl_member_of_derived_class(this, _first_pointer);
+            while(crt != dst)
+            {
+               crt->~value_type();
+               crt = _inc_pointer(crt);
+            }
+            for(size_t i=0; i<remaining_constructions; ++i)
+            {
+               crt = _inc_pointer(crt);
+            }
+            _sstl_member_of_derived_class(this, _first_pointer) = crt;
+            _sstl_member_of_derived_class(this, _size) -= count;
+            throw;
          }
-
-         return iterator{this, dst_end};
+         #endif
+         auto number_of_assignments = count-number_of_constructions;
+         for(size_type i=number_of_assignments; i>0; --i)
+         {
+            *dst = value;
+            dst = _inc_pointer(dst);
+         }
+         return iterator{ this, new_region_first_pointer };
       }
       else
       {
-         auto src = _sstl_member_of_derived_class(this, _last_pointer);
-         auto dst = _inc_pointer(_sstl_member_of_derived_class(this, _last_pointer));
-         auto dst_end = _subtract_offset_to_pointer(dst, distance_to_end);
-
-         if(distance_to_end > 0)
+         auto new_region_last_pointer = _shift_from_pos_to_end_by_n_positions(count, distance_to_end);
+         auto dst = new_region_last_pointer;
+         auto number_of_constructions = count > distance_to_end ? count-distance_to_end : 0;
+         #if _sstl_has_exceptions()
+         try
          {
-            new(dst) value_type(std::move(*src));
-            _sstl_member_of_derived_class(this, _last_pointer) = dst;
-            ++_sstl_member_of_derived_class(this, _size);
-
-            src = _dec_pointer(src);
-            dst = _dec_pointer(dst);
-
-            while(dst != dst_end)
+         #endif
+            for(size_type i=number_of_constructions; i>0; --i)
             {
-               *dst = std::move(*src);
-               src = _dec_pointer(src);
+               new(dst) value_type(value);
                dst = _dec_pointer(dst);
             }
-            *dst_end = std::forward<TValue>(value);
+         #if _sstl_has_exceptions()
          }
-         else
+         catch(...)
          {
-            new(dst_end) value_type(std::forward<TValue>(value));
-            _sstl_member_of_derived_class(this, _last_pointer) = dst;
-            ++_sstl_member_of_derived_class(this, _size);
+            while (dst != _sstl_member_of_derived_class(this, _last_pointer))
+            {
+               dst = _inc_pointer(dst);
+               dst->~value_type();
+            }
+            _sstl_member_of_derived_class(this, _last_pointer) =
+               _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), count);
+            _sstl_member_of_derived_class(this, _size) -= count;
+            throw;
          }
-
-         return iterator{this, dst_end};
+         #endif
+         auto number_of_assignments = count - number_of_constructions;
+         for(size_type i=number_of_assignments; i>0; --i)
+         {
+            *dst = value;
+            dst = _dec_pointer(dst);
+         }
+         return iterator{ this, _inc_pointer(dst) };
       }
    }
 
-   pointer _shift_from_begin_to_pos_by_n_positions(size_type n, size_type distance_to_begin)
-      _sstl_noexcept(   std::is_nothrow_move_constructible<value_type>::value
-                     && std::is_nothrow_move_assignable<value_type>::value)
+   // std::true_type -> trivially relocatable value type
+   template<class TIterator>
+   iterator _insert_range(const_iterator pos, TIterator range_begin, size_type count, std::true_type)
+      _sstl_noexcept(std::is_nothrow_copy_constructible<value_type>::value)
    {
-      auto number_of_constructions = std::min(n, distance_to_begin);
-      auto number_of_assignments = distance_to_begin - number_of_constructions;
+      return _insert_by_relocation(pos, count, [&range_begin](pointer dst)
+      {
+         new(dst) value_type(*range_begin);
+         ++range_begin;
+      });
+   }
 
-      auto dst_first = _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _first_pointer), n);
-      auto dst = dst_first;
-      auto src = _sstl_member_of_derived_class(this, _first_pointer);
+   // std::false_type -> the elements on the shorter side of pos are shifted by move constructions and assignments
+   template<class TIterator>
+   iterator _insert_range(const_iterator pos, TIterator range_begin, size_type count, std::false_type)
+      _sstl_noexcept(
+            noexcept(std::declval<deque>()._shift_from_begin_to_pos_by_n_positions(  std::declval<size_type>(),
+                                                                                       std::declval<difference_type>()))
+         && noexcept(std::declval<deque>()._shift_from_pos_to_end_by_n_positions( std::declval<size_type>(),
+                                                                                    std::declval<difference_type>()))
+         && std::is_nothrow_copy_constructible<value_type>::value
+         && std::is_nothrow_copy_assignable<value_type>::value)
+   {
+      auto distance_to_begin = static_cast<size_type>(std::distance(cbegin(), pos));
+      auto distance_to_end = static_cast<size_type>(std::distance(pos, cend()));
+      auto range_pos = range_begin;
 
-      size_type remaining_constructions;
-      #if _sstl_has_exceptions()
-      try
+      if(distance_to_begin < distance_to_end)
       {
-      #endif
-         for(remaining_constructions=number_of_constructions; remaining_constructions>0; --remaining_constructions)
+         auto new_region_first_pointer = _shift_from_begin_to_pos_by_n_positions(count, distance_to_begin);
+         auto dst = new_region_first_pointer;
+         auto number_of_constructions = count > distance_to_begin ? count-distance_to_begin : 0;
+         size_type remaining_constructions;
+         #if _sstl_has_exceptions()
+         try
          {
-            new(dst) value_type(std::move(*src));
-            src = _inc_pointer(src);
-            dst = _inc_pointer(dst);
+         #endif
+            for(remaining_constructions=number_of_constructions; remaining_constructions>0; --remaining_constructions)
+            {
+               new(dst) value_type(*range_pos);
+               ++range_pos;
+               dst = _inc_pointer(dst);
+            }
+         #if _sstl_has_exceptions()
          }
-
-         for(size_type i=number_of_assignments; i>0; i--)
+         catch(...)
          {
-            *dst = std::move(*src);
-            src = _inc_pointer(src);
+            auto crt = _sstl_member_of_derived_class(this, _first_pointer);
+            while(crt != dst)
+            {
+               crt->~value_type();
+               crt = _inc_pointer(crt);
+            }
+            for(size_t i=0; i<remaining_constructions; ++i)
+            {
+               crt = _inc_pointer(crt);
+            }
+            _sstl_member_of_derived_class(this, _first_pointer) = crt;
+            _sstl_member_of_derived_class(this, _size) -= count;
+            throw;
+         }
+         #endif
+         auto number_of_assignments = count-number_of_constructions;
+         for(size_type i=number_of_assignments; i>0; --i)
+         {
+            *dst = *range_pos;
+            ++range_pos;
+            dst = _inc_pointer(dst);
+         }
+         return iterator{ this, new_region_first_pointer };
+      }
+      else
+      {
+         auto new_region_last_pointer = _shift_from_pos_to_end_by_n_positions(count, distance_to_end);
+         auto new_region_first_pointer = _subtract_offset_to_pointer(new_region_last_pointer, count > 0 ? count-1 : 0);
+         auto dst = new_region_first_pointer;
+         auto number_of_constructions = count > distance_to_end ? count-distance_to_end : 0;
+         auto number_of_assignments = count - number_of_constructions;
+
+         size_type remaining_assignments = number_of_assignments;
+         size_type remaining_constructions = number_of_constructions;
+         #if _sstl_has_exceptions()
+         try
+         {
+         #endif
+            while(remaining_assignments > 0)
+            {
+               *dst = *range_pos;
+               ++range_pos;
+               dst = _inc_pointer(dst);
+               --remaining_assignments;
+            }
+            while(remaining_constructions > 0)
+            {
+               new(dst) value_type(*range_pos);
+               ++range_pos;
+               dst = _inc_pointer(dst);
+               --remaining_constructions;
+            }
+         #if _sstl_has_exceptions()
+         }
+         catch(...)
+         {
+            for(size_type i=0; i<remaining_assignments; ++i)
+            {
+               dst = _inc_pointer(dst);
+            }
+            for(size_type i=0; i<remaining_constructions; ++i)
+            {
+               dst = _inc_pointer(dst);
+            }
+            for(size_type i=0; i<distance_to_end; ++i)
+            {
+               dst->~value_type();
+               dst = _inc_pointer(dst);
+            }
+            auto constructions_done = number_of_constructions-remaining_constructions;
+            _sstl_member_of_derived_class(this, _last_pointer) =
+               _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), count - constructions_done);
+            _sstl_member_of_derived_class(this, _size) -= (count - constructions_done);
+            throw;
+         }
+         #endif
+         return iterator{ this, new_region_first_pointer };
+      }
+   }
+
+   template<class TValue>
+   iterator _emplace_value(const_iterator pos, TValue&& value)
+      _sstl_noexcept(std::is_nothrow_move_constructible<value_type>()
+                  && std::is_nothrow_move_assignable<value_type>())
+   {
+      sstl_assert(!full());
+      return _emplace_value(pos, std::forward<TValue>(value), _is_trivially_relocatable{});
+   }
+
+   // std::true_type -> trivially relocatable value type
+   template<class TValue>
+   iterator _emplace_value(const_iterator pos, TValue&& value, std::true_type)
+      _sstl_noexcept(std::is_nothrow_move_constructible<value_type>())
+   {
+      if(_is_in_storage(std::addressof(value))) //the value is an element that might get relocated
+      {
+         value_type copy(std::forward<TValue>(value));
+         return _insert_by_relocation(pos, 1, [&copy](pointer dst){ new(dst) value_type(std::move(copy)); });
+      }
+      return _insert_by_relocation(pos, 1, [&value](pointer dst){ new(dst) value_type(std::forward<TValue>(value)); });
+   }
+
+   // std::false_type -> the elements on the shorter side of pos are shifted by move constructions and assignments
+   template<class TValue>
+   iterator _emplace_value(const_iterator pos, TValue&& value, std::false_type)
+      _sstl_noexcept(std::is_nothrow_move_constructible<value_type>()
+                  && std::is_nothrow_move_assignable<value_type>())
+   {
+      auto distance_to_begin = std::distance(cbegin(), pos);
+      auto distance_to_end = std::distance(pos, cend());
+      if(distance_to_begin < distance_to_end)
+      {
+         auto src = _sstl_member_of_derived_class(this, _first_pointer);
+         auto dst = _dec_pointer(_sstl_member_of_derived_class(this, _first_pointer));
+         auto dst_end = _add_offset_to_pointer(dst, distance_to_begin);
+
+         if(distance_to_begin > 0)
+         {
+            new(dst) value_type(std::move(*src));
+            _sstl_member_of_derived_class(this, _first_pointer) = dst;
+            ++_sstl_member_of_derived_class(this, _size);
+
+            src = _inc_pointer(src);
+            dst = _inc_pointer(dst);
+
+            while(dst != dst_end)
+            {
+               *dst = std::move(*src);
+               src = _inc_pointer(src);
+               dst = _inc_pointer(dst);
+            }
+            *dst_end = std::forward<TValue>(value);
+         }
+         else
+         {
+            new(dst_end) value_type(std::forward<TValue>(value));
+            _sstl_member_of_derived_class(this, _first_pointer) = dst;
+            ++_sstl_member_of_derived_class(this, _size);
+         }
+
+         return iterator{this, dst_end};
+      }
+      else
+      {
+         auto src = _sstl_member_of_derived_class(this, _last_pointer);
+         auto dst = _inc_pointer(_sstl_member_of_derived_class(this, _last_pointer));
+         auto dst_end = _subtract_offset_to_pointer(dst, distance_to_end);
+
+         if(distance_to_end > 0)
+         {
+            new(dst) value_type(std::move(*src));
+            _sstl_member_of_derived_class(this, _last_pointer) = dst;
+            ++_sstl_member_of_derived_class(this, _size);
+
+            src = _dec_pointer(src);
+            dst = _dec_pointer(dst);
+
+            while(dst != dst_end)
+            {
+               *dst = std::move(*src);
+               src = _dec_pointer(src);
+               dst = _dec_pointer(dst);
+            }
+            *dst_end = std::forward<TValue>(value);
+         }
+         else
+         {
+            new(dst_end) value_type(std::forward<TValue>(value));
+            _sstl_member_of_derived_class(this, _last_pointer) = dst;
+            ++_sstl_member_of_derived_class(this, _size);
+         }
+
+         return iterator{this, dst_end};
+      }
+   }
+
+   // std::true_type -> the erased elements are destroyed and the elements on the shorter side
+   // of pos are relocated with raw memory moves
+   iterator _erase(const_iterator pos, std::true_type)
+      _sstl_noexcept(std::is_nothrow_destructible<value_type>::value)
+   {
+      return _erase(pos, pos+1, std::true_type{});
+   }
+
+   // std::false_type -> the elements on the shorter side of pos are shifted by move assignments
+   iterator _erase(const_iterator pos, std::false_type)
+      _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value)
+   {
+      auto distance_to_begin = static_cast<size_type>(pos - cbegin());
+      auto distance_to_end = static_cast<size_type>(cend() - pos);
+      auto pos_pointer = const_cast<pointer>(pos._pos);
+      if(distance_to_begin < distance_to_end)
+      {
+         auto src = _dec_pointer(pos_pointer);
+         auto dst = pos_pointer;
+         while (dst != _sstl_member_of_derived_class(this, _first_pointer))
+         {
+            *dst = std::move(*src);
+            dst = src;
+            src = _dec_pointer(src);
+         }
+         _sstl_member_of_derived_class(this, _first_pointer)->~value_type();
+         _sstl_member_of_derived_class(this, _first_pointer) = _inc_pointer(_sstl_member_of_derived_class(this, _first_pointer));
+         --_sstl_member_of_derived_class(this, _size);
+         return iterator{ this, _inc_pointer(pos_pointer) };
+      }
+      else
+      {
+         auto src = _inc_pointer(pos_pointer);
+         auto dst = pos_pointer;
+         while (dst != _sstl_member_of_derived_class(this, _last_pointer))
+         {
+            *dst = std::move(*src);
+            dst = src;
+            src = _inc_pointer(src);
+         }
+         auto pos_pointer_to_return =  pos_pointer != _sstl_member_of_derived_class(this, _last_pointer)
+                                       ? pos_pointer : nullptr;
+         _sstl_member_of_derived_class(this, _last_pointer)->~value_type();
+         _sstl_member_of_derived_class(this, _last_pointer) = _dec_pointer(_sstl_member_of_derived_class(this, _last_pointer));
+         --_sstl_member_of_derived_class(this, _size);
+         return iterator{ this, pos_pointer_to_return };
+      }
+   }
+
+   // std::true_type -> the erased elements are destroyed and the elements on the shorter side
+   // of the range are relocated with raw memory moves
+   iterator _erase(const_iterator range_begin, const_iterator range_end, std::true_type)
+      _sstl_noexcept(std::is_nothrow_destructible<value_type>::value)
+   {
+      auto distance_to_begin = static_cast<size_type>(range_begin - cbegin());
+      auto distance_to_end = static_cast<size_type>(cend() - range_end);
+      auto range_size = static_cast<size_type>(range_end - range_begin);
+      auto range_first_pointer = const_cast<pointer>(range_begin._pos);
+      auto crt = range_first_pointer;
+      for(size_type i=range_size; i>0; --i)
+      {
+         crt->~value_type();
+         crt = _inc_pointer(crt);
+      }
+      _sstl_member_of_derived_class(this, _size) -= range_size;
+      if(distance_to_begin < distance_to_end)
+      {
+         auto first = _sstl_member_of_derived_class(this, _first_pointer);
+         auto new_first = _add_offset_to_pointer(first, range_size);
+         _relocate_elements_towards_back(new_first, first, distance_to_begin);
+         _sstl_member_of_derived_class(this, _first_pointer) = new_first;
+         return iterator{ this, const_cast<pointer>(range_end._pos) };
+      }
+      else
+      {
+         _relocate_elements_towards_front(range_first_pointer, crt, distance_to_end);
+         _sstl_member_of_derived_class(this, _last_pointer) =
+            _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), range_size);
+         return iterator{ this, distance_to_end > 0 ? range_first_pointer : nullptr };
+      }
+   }
+
+   iterator _erase(const_iterator range_begin, const_iterator range_end, std::false_type)
+      _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value)
+   {
+      auto distance_to_begin = static_cast<size_type>(range_begin - cbegin());
+      auto distance_to_end = static_cast<size_type>(cend() - range_end);
+      auto range_size = range_end - range_begin;
+      if(distance_to_begin < distance_to_end)
+      {
+         auto src = const_cast<pointer>(range_begin._pos);
+         auto dst = (range_end != cend())
+                  ? const_cast<pointer>(_dec_pointer(range_end._pos))
+                  : _sstl_member_of_derived_class(this, _last_pointer);
+         while (src != _sstl_member_of_derived_class(this, _first_pointer))
+         {
+            src = _dec_pointer(src);
+            *dst = std::move(*src);
+            dst = _dec_pointer(dst);
+         }
+         auto new_first_pointer = _inc_pointer(dst);
+         while(true)
+         {
+            dst->~value_type();
+            if (dst == _sstl_member_of_derived_class(this, _first_pointer))
+               break;
+            dst = _dec_pointer(dst);
+         };
+         _sstl_member_of_derived_class(this, _first_pointer) = new_first_pointer;
+         _sstl_member_of_derived_class(this, _size) -= range_size;
+         return iterator{ this, const_cast<pointer>(range_end._pos) };
+      }
+      else
+      {
+         auto src = (range_end != cend())
+                  ? const_cast<pointer>(_dec_pointer(range_end._pos))
+                  : _sstl_member_of_derived_class(this, _last_pointer);
+         auto dst = const_cast<pointer>(range_begin._pos);
+         while (src != _sstl_member_of_derived_class(this, _last_pointer))
+         {
+            src = _inc_pointer(src);
+            *dst = std::move(*src);
+            dst = _inc_pointer(dst);
+         }
+         auto new_last_pointer = _dec_pointer(dst);
+         while(true)
+         {
+            dst->~value_type();
+            if (dst == _sstl_member_of_derived_class(this, _last_pointer))
+               break;
+            dst = _inc_pointer(dst);
+         }
+         pointer return_pos = (range_end._pos != nullptr)
+                           ? const_cast<pointer>(range_begin._pos)
+                           : nullptr;
+         _sstl_member_of_derived_class(this, _last_pointer) = new_last_pointer;
+         _sstl_member_of_derived_class(this, _size) -= range_size;
+         return iterator{ this, return_pos };
+      }
+   }
+
+   pointer _shift_from_begin_to_pos_by_n_positions(size_type n, size_type distance_to_begin)
+      _sstl_noexcept(   std::is_nothrow_move_constructible<value_type>::value
+                     && std::is_nothrow_move_assignable<value_type>::value)
+   {
+      auto number_of_constructions = std::min(n, distance_to_begin);
+      auto number_of_assignments = distance_to_begin - number_of_constructions;
+
+      auto dst_first = _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _first_pointer), n);
+      auto dst = dst_first;
+      auto src = _sstl_member_of_derived_class(this, _first_pointer);
+
+      size_type remaining_constructions;
+      #if _sstl_has_exceptions()
+      try
+      {
+      #endif
+         for(remaining_constructions=number_of_constructions; remaining_constructions>0; --remaining_constructions)
+         {
+            new(dst) value_type(std::move(*src));
+            src = _inc_pointer(src);
+            dst = _inc_pointer(dst);
+         }
+
+         for(size_type i=number_of_assignments; i>0; i--)
+         {
+            *dst = std::move(*src);
+            src = _inc_pointer(src);
+            dst = _inc_pointer(dst);
+         }
+      #if _sstl_has_exceptions()
+      }
+      catch(...)
+      {
+         auto destructions = number_of_constructions - remaining_constructions;
+         auto ptr = dst_first;
+         for(size_type i=destructions; i>0; --i)
+         {
+            ptr->~value_type();
+            ptr = _inc_pointer(ptr);
+         }
+         throw;
+      }
+      #endif
+
+      _sstl_member_of_derived_class(this, _first_pointer) =
+         _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _first_pointer), n);
+      _sstl_member_of_derived_class(this, _size) += n;
+
+      return _add_offset_to_pointer(_sstl_member_of_derived_class(this, _first_pointer), distance_to_begin);
+   }
+
+   pointer _shift_from_pos_to_end_by_n_positions(size_type n, size_type distance_to_end)
+      _sstl_noexcept(   std::is_nothrow_move_constructible<value_type>::value
+                     && std::is_nothrow_move_assignable<value_type>::value)
+   {
+      auto number_of_constructions = std::min(n, distance_to_end);
+      auto number_of_assignments = distance_to_end - number_of_constructions;
+
+      auto dst_first = _add_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), n);
+      auto dst = dst_first;
+      auto src = _sstl_member_of_derived_class(this, _last_pointer);
+
+      size_type remaining_constructions;
+      #if _sstl_has_exceptions()
+      try
+      {
+      #endif
+         for(remaining_constructions=number_of_constructions; remaining_constructions>0; --remaining_constructions)
+         {
+            new(dst) value_type(std::move(*src));
+            src = _dec_pointer(src);
+            dst = _dec_pointer(dst);
+         }
+
+         for(size_type i=number_of_assignments; i>0; --i)
+         {
+            *dst = std::move(*src);
+            src = _dec_pointer(src);
+            dst = _dec_pointer(dst);
+         }
+      #if _sstl_has_exceptions()
+      }
+      catch(...)
+      {
+         auto destructions = number_of_constructions - remaining_constructions;
+         auto ptr = dst_first;
+         for(size_type i=0; i<destructions; ++i)
+         {
+            ptr->~value_type();
+            ptr = _dec_pointer(ptr);
+         }
+         throw;
+      }
+      #endif
+
+      _sstl_member_of_derived_class(this, _last_pointer) =
+         _add_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), n);
+      _sstl_member_of_derived_class(this, _size) += n;
+
+      return _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), distance_to_end);
+   }
+
+   //relocating counterparts of the two functions above: they shift the elements with raw memory moves,
+   //which leaves all the n positions of the new region uninitialized
+   pointer _relocate_from_begin_to_pos_by_n_positions(size_type n, size_type distance_to_begin) _sstl_noexcept_
+   {
+      auto first = _sstl_member_of_derived_class(this, _first_pointer);
+      auto new_first = _subtract_offset_to_pointer(first, n);
+      _relocate_elements_towards_front(new_first, first, distance_to_begin);
+
+      _sstl_member_of_derived_class(this, _first_pointer) = new_first;
+      _sstl_member_of_derived_class(this, _size) += n;
+
+      return _add_offset_to_pointer(new_first, distance_to_begin);
+   }
+
+   pointer _relocate_from_pos_to_end_by_n_positions(size_type n, size_type distance_to_end) _sstl_noexcept_
+   {
+      auto src = _subtract_offset_to_pointer(_inc_pointer(_sstl_member_of_derived_class(this, _last_pointer)),
+                                             distance_to_end);
+      _relocate_elements_towards_back(_add_offset_to_pointer(src, n), src, distance_to_end);
+
+      _sstl_member_of_derived_class(this, _last_pointer) =
+         _add_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), n);
+      _sstl_member_of_derived_class(this, _size) += n;
+
+      return _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), distance_to_end);
+   }
+
+   //inserts count elements at pos, each constructed into raw memory by the specified function.
+   //The gap is opened by relocating the elements on the shorter side of pos. If a construction throws,
+   //the constructed elements are destroyed and the relocated ones are moved back (strong exception guarantee)
+   template<class TConstruct>
+   iterator _insert_by_relocation(const_iterator pos, size_type count, TConstruct construct)
+   {
+      auto distance_to_begin = static_cast<size_type>(std::distance(cbegin(), pos));
+      auto distance_to_end = static_cast<size_type>(std::distance(pos, cend()));
+      auto is_front_relocation = distance_to_begin < distance_to_end;
+      auto new_region_first_pointer = is_front_relocation
+         ? _relocate_from_begin_to_pos_by_n_positions(count, distance_to_begin)
+         : _subtract_offset_to_pointer(_relocate_from_pos_to_end_by_n_positions(count, distance_to_end), count-1);
+      auto dst = new_region_first_pointer;
+      #if _sstl_has_exceptions()
+      try
+      {
+      #endif
+         for(size_type i=count; i>0; --i)
+         {
+            construct(dst);
             dst = _inc_pointer(dst);
          }
       #if _sstl_has_exceptions()
       }
       catch(...)
       {
-         auto destructions = number_of_constructions - remaining_constructions;
-         auto ptr = dst_first;
-         for(size_type i=destructions; i>0; --i)
+         for(auto crt=new_region_first_pointer; crt!=dst; crt=_inc_pointer(crt))
+            crt->~value_type();
+         if(is_front_relocation)
          {
-            ptr->~value_type();
-            ptr = _inc_pointer(ptr);
+            auto first = _sstl_member_of_derived_class(this, _first_pointer);
+            _relocate_elements_towards_back(_add_offset_to_pointer(first, count), first, distance_to_begin);
+            _sstl_member_of_derived_class(this, _first_pointer) = _add_offset_to_pointer(first, count);
+         }
+         else
+         {
+            _relocate_elements_towards_front(  new_region_first_pointer,
+                                               _add_offset_to_pointer(new_region_first_pointer, count),
+                                               distance_to_end);
+            _sstl_member_of_derived_class(this, _last_pointer) =
+               _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), count);
          }
+         _sstl_member_of_derived_class(this, _size) -= count;
          throw;
       }
       #endif
+      return iterator{ this, new_region_first_pointer };
+   }
 
-      _sstl_member_of_derived_class(this, _first_pointer) =
-         _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _first_pointer), n);
-      _sstl_member_of_derived_class(this, _size) += n;
+   //moves count elements from the (possibly wrapping around) range starting at src to the one
+   //starting at dst, which precedes it. Performs one memmove per contiguous chunk of the two ranges
+   void _relocate_elements_towards_front(pointer dst, pointer src, size_type count) _sstl_noexcept_
+   {
+      auto end_storage = const_cast<pointer>(_sstl_member_of_derived_class(this, _end_storage));
+      while(count > 0)
+      {
+         auto chunk = std::min(count, static_cast<size_type>(std::min(end_storage - src, end_storage - dst)));
+         _memmove_elements(dst, src, chunk);
+         src = _add_offset_to_pointer(src, chunk);
+         dst = _add_offset_to_pointer(dst, chunk);
+         count -= chunk;
+      }
+   }
 
-      return _add_offset_to_pointer(_sstl_member_of_derived_class(this, _first_pointer), distance_to_begin);
+   //same as above, but the destination range follows the source one, hence the chunks are moved backwards
+   void _relocate_elements_towards_back(pointer dst, pointer src, size_type count) _sstl_noexcept_
+   {
+      if(count == 0)
+         return;
+      auto begin_storage = const_cast<pointer>(_begin_storage());
+      auto end_storage = const_cast<pointer>(_sstl_member_of_derived_class(this, _end_storage));
+      auto src_end = _add_offset_to_pointer(src, count-1) + 1;
+      auto dst_end = _add_offset_to_pointer(dst, count-1) + 1;
+      while(count > 0)
+      {
+         auto chunk = std::min(count, static_cast<size_type>(std::min(src_end - begin_storage, dst_end - begin_storage)));
+         src_end -= chunk;
+         dst_end -= chunk;
+         _memmove_elements(dst_end, src_end, chunk);
+         if(src_end == begin_storage)
+            src_end = end_storage;
+         if(dst_end == begin_storage)
+            dst_end = end_storage;
+         count -= chunk;
+      }
    }
 
-   pointer _shift_from_pos_to_end_by_n_positions(size_type n, size_type distance_to_end)
-      _sstl_noexcept(   std::is_nothrow_move_constructible<value_type>::value
-                     && std::is_nothrow_move_assignable<value_type>::value)
+   template<class TIterator>
+   void _push_back_n(TIterator range_begin, size_type count, std::true_type) _sstl_noexcept_
    {
-      auto number_of_constructions = std::min(n, distance_to_end);
-      auto number_of_assignments = distance_to_end - number_of_constructions;
+      for(const auto& crt : _segments(_inc_pointer(_sstl_member_of_derived_class(this, _last_pointer)), count))
+      {
+         _memcpy_elements(crt.data, range_begin, crt.size);
+         range_begin += crt.size;
+      }
+      _commit_back_n(count);
+   }
 
-      auto dst_first = _add_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), n);
-      auto dst = dst_first;
-      auto src = _sstl_member_of_derived_class(this, _last_pointer);
+   template<class TIterator>
+   void _push_back_n(TIterator range_begin, size_type count, std::false_type)
+      _sstl_noexcept(noexcept(value_type(*std::declval<TIterator&>())))
+   {
+      _construct_back_n(count, [&range_begin](pointer dst)
+      {
+         new(dst) value_type(*range_begin);
+         ++range_begin;
+      });
+   }
 
-      size_type remaining_constructions;
+   //constructs count elements after the last one with the specified function, then appends them.
+   //If a construction throws, the constructed elements are destroyed (strong exception guarantee)
+   template<class TConstruct>
+   void _construct_back_n(size_type count, TConstruct construct)
+   {
+      auto first = _inc_pointer(_sstl_member_of_derived_class(this, _last_pointer));
+      auto dst = first;
       #if _sstl_has_exceptions()
       try
       {
       #endif
-         for(remaining_constructions=number_of_constructions; remaining_constructions>0; --remaining_constructions)
+         for(size_type i=count; i>0; --i)
          {
-            new(dst) value_type(std::move(*src));
-            src = _dec_pointer(src);
-            dst = _dec_pointer(dst);
+            construct(dst);
+            dst = _inc_pointer(dst);
          }
+      #if _sstl_has_exceptions()
+      }
+      catch(...)
+      {
+         for(auto crt=first; crt!=dst; crt=_inc_pointer(crt))
+            crt->~value_type();
+         throw;
+      }
+      #endif
+      _commit_back_n(count);
+   }
 
-         for(size_type i=number_of_assignments; i>0; --i)
+   void _commit_back_n(size_type count) _sstl_noexcept_
+   {
+      _sstl_member_of_derived_class(this, _last_pointer) =
+         _add_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), count);
+      _sstl_member_of_derived_class(this, _size) += count;
+   }
+
+   template<class TOutputIterator>
+   TOutputIterator _pop_front_n(TOutputIterator out, size_type count, std::true_type) _sstl_noexcept_
+   {
+      for(const auto& crt : _segments(_sstl_member_of_derived_class(this, _first_pointer), count))
+      {
+         _memcpy_elements(out, crt.data, crt.size);
+         out += crt.size;
+      }
+      _sstl_member_of_derived_class(this, _first_pointer) =
+         _add_offset_to_pointer(_sstl_member_of_derived_class(this, _first_pointer), count);
+      _sstl_member_of_derived_class(this, _size) -= count;
+      return out;
+   }
+
+   //if a move assignment throws, the elements moved so far are removed
+   template<class TOutputIterator>
+   TOutputIterator _pop_front_n(TOutputIterator out, size_type count, std::false_type)
+      _sstl_noexcept(noexcept(*std::declval<TOutputIterator&>() = std::declval<value_type&&>())
+                     && std::is_nothrow_destructible<value_type>::value)
+   {
+      auto src = _sstl_member_of_derived_class(this, _first_pointer);
+      size_type popped = 0;
+      #if _sstl_has_exceptions()
+      try
+      {
+      #endif
+         for(; popped<count; ++popped)
          {
-            *dst = std::move(*src);
-            src = _dec_pointer(src);
-            dst = _dec_pointer(dst);
+            *out = std::move(*src);
+            ++out;
+            src->~value_type();
+            src = _inc_pointer(src);
          }
       #if _sstl_has_exceptions()
       }
       catch(...)
       {
-         auto destructions = number_of_constructions - remaining_constructions;
-         auto ptr = dst_first;
-         for(size_type i=0; i<destructions; ++i)
-         {
-            ptr->~value_type();
-            ptr = _dec_pointer(ptr);
-         }
+         _sstl_member_of_derived_class(this, _first_pointer) = src;
+         _sstl_member_of_derived_class(this, _size) -= popped;
          throw;
       }
       #endif
+      _sstl_member_of_derived_class(this, _first_pointer) = src;
+      _sstl_member_of_derived_class(this, _size) -= count;
+      return out;
+   }
 
-      _sstl_member_of_derived_class(this, _last_pointer) =
-         _add_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), n);
-      _sstl_member_of_derived_class(this, _size) += n;
+   std::array<segment, 2> _segments(pointer first, size_type count) _sstl_noexcept_
+   {
+      auto end_storage = const_cast<pointer>(_sstl_member_of_derived_class(this, _end_storage));
+      auto first_segment_size = std::min(count, static_cast<size_type>(end_storage - first));
+      return {{ segment{ first, first_segment_size }, segment{ _begin_storage(), count - first_segment_size } }};
+   }
 
-      return _subtract_offset_to_pointer(_sstl_member_of_derived_class(this, _last_pointer), distance_to_end);
+   bool _is_in_storage(const_pointer ptr) const _sstl_noexcept_
+   {
+      return ptr >= _begin_storage() && ptr < _sstl_member_of_derived_class(this, _end_storage);
+   }
+
+   static void _memcpy_elements(pointer dst, const_pointer src, size_type count) _sstl_noexcept_
+   {
+      if(count > 0)
+         std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(value_type));
+   }
+
+   static void _memmove_elements(pointer dst, const_pointer src, size_type count) _sstl_noexcept_
+   {
+      std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(value_type));
    }
 
    pointer _inc_pointer(pointer ptr) const _sstl_noexcept_
@@ -1271,6 +1823,8 @@ public:
    using const_iterator = typename _base::const_iterator;
    using reverse_iterator = typename _base::reverse_iterator;
    using const_reverse_iterator = typename _base::const_reverse_iterator;
+   using linear_iterator = _deque_linear_iterator<value_type, CAPACITY>;
+   using const_linear_iterator = _deque_linear_iterator<const value_type, CAPACITY>;
 
 public:
    deque() _sstl_noexcept_
@@ -1370,11 +1924,252 @@ public:
       return reinterpret_cast<deque&>(_base::operator=(ilist));
    }
 
+   //the hot non-modifying operations hide the ones of the capacity-agnostic base: when the sized type
+   //is known, the member variables are accessed directly and the capacity is a compile-time constant
+   reference operator[](size_type idx) _sstl_noexcept_
+   {
+      sstl_assert(idx < _size);
+      return *_wrap(_offset(_first_pointer) + idx);
+   }
+
+   const_reference operator[](size_type idx) const _sstl_noexcept_
+   {
+      return const_cast<deque&>(*this)[idx];
+   }
+
+   reference front() _sstl_noexcept_
+   {
+      sstl_assert(!empty());
+      return *_first_pointer;
+   }
+
+   const_reference front() const _sstl_noexcept_
+   {
+      sstl_assert(!empty());
+      return *_first_pointer;
+   }
+
+   reference back() _sstl_noexcept_
+   {
+      sstl_assert(!empty());
+      return *_last_pointer;
+   }
+
+   const_reference back() const _sstl_noexcept_
+   {
+      sstl_assert(!empty());
+      return *_last_pointer;
+   }
+
+   bool empty() const _sstl_noexcept_
+   {
+      return _size == 0;
+   }
+
+   bool full() const _sstl_noexcept_
+   {
+      return _size == CAPACITY;
+   }
+
+   size_type size() const _sstl_noexcept_
+   {
+      return _size;
+   }
+
+   size_type max_size() const _sstl_noexcept_
+   {
+      return CAPACITY;
+   }
+
+   size_type capacity() const _sstl_noexcept_
+   {
+      return CAPACITY;
+   }
+
+   //the linear iterators are an alternative to the (capacity-agnostic) iterators for the STL algorithms:
+   //they are faster, but they don't mix with the iterators and aren't accepted by the member functions
+   linear_iterator linear_begin() _sstl_noexcept_
+   {
+      return linear_iterator{ _storage(), _offset(_first_pointer) };
+   }
+
+   const_linear_iterator linear_begin() const _sstl_noexcept_
+   {
+      return const_cast<deque&>(*this).linear_begin();
+   }
+
+   const_linear_iterator linear_cbegin() const _sstl_noexcept_
+   {
+      return linear_begin();
+   }
+
+   linear_iterator linear_end() _sstl_noexcept_
+   {
+      return linear_iterator{ _storage(), _offset(_first_pointer) + _size };
+   }
+
+   const_linear_iterator linear_end() const _sstl_noexcept_
+   {
+      return const_cast<deque&>(*this).linear_end();
+   }
+
+   const_linear_iterator linear_cend() const _sstl_noexcept_
+   {
+      return linear_end();
+   }
+
+   //the hot modifying operations at the ends hide the ones of the base as well, so that
+   //their positions wrap around with the specialized arithmetic (see _wrap)
+   void push_front(const_reference value)
+      _sstl_noexcept(noexcept(std::declval<deque>().emplace_front(std::declval<const_reference>())))
+   {
+      emplace_front(value);
+   }
+
+   void push_front(value_type&& value)
+      _sstl_noexcept(noexcept(std::declval<deque>().emplace_front(std::declval<value_type&&>())))
+   {
+      emplace_front(std::move(value));
+   }
+
+   template<class... Args>
+   void emplace_front(Args&&... args)
+      _sstl_noexcept(std::is_nothrow_constructible<value_type, typename std::add_rvalue_reference<Args>::type...>::value)
+   {
+      _sstl_record_container_stats(this);
+      sstl_assert(!full());
+      auto new_first_pointer = _wrap(_offset(_first_pointer) + CAPACITY - 1);
+      new(new_first_pointer) value_type(std::forward<Args>(args)...);
+      _first_pointer = new_first_pointer;
+      ++_size;
+   }
+
+   void push_back(const_reference value)
+      _sstl_noexcept(noexcept(std::declval<deque>().emplace_back(std::declval<const_reference>())))
+   {
+      emplace_back(value);
+   }
+
+   void push_back(value_type&& value)
+      _sstl_noexcept(noexcept(std::declval<deque>().emplace_back(std::declval<value_type&&>())))
+   {
+      emplace_back(std::move(value));
+   }
+
+   template<class... Args>
+   void emplace_back(Args&&... args)
+      _sstl_noexcept(std::is_nothrow_constructible<value_type, typename std::add_rvalue_reference<Args>::type...>::value)
+   {
+      _sstl_record_container_stats(this);
+      sstl_assert(!full());
+      auto new_last_pointer = _wrap(_offset(_last_pointer) + 1);
+      new(new_last_pointer) value_type(std::forward<Args>(args)...);
+      _last_pointer = new_last_pointer;
+      ++_size;
+   }
+
+   //appends the value even if the deque is full, in which case the first element is overwritten,
+   //i.e. the deque behaves as a circular buffer holding the newest elements (see sstl::circular_buffer)
+   void push_back_overwrite(const_reference value)
+      _sstl_noexcept(noexcept(std::declval<deque>().emplace_back_overwrite(std::declval<const_reference>())))
+   {
+      emplace_back_overwrite(value);
+   }
+
+   void push_back_overwrite(value_type&& value)
+      _sstl_noexcept(noexcept(std::declval<deque>().emplace_back_overwrite(std::declval<value_type&&>())))
+   {
+      emplace_back_overwrite(std::move(value));
+   }
+
+   template<class... Args>
+   void emplace_back_overwrite(Args&&... args)
+      _sstl_noexcept(noexcept(std::declval<deque>()._emplace_back_overwrite(std::is_trivially_destructible<value_type>{},
+                                                                             std::declval<Args>()...)))
+   {
+      _sstl_record_container_stats(this);
+      _emplace_back_overwrite(std::is_trivially_destructible<value_type>{}, std::forward<Args>(args)...);
+   }
+
+   void pop_back() _sstl_noexcept_
+   {
+      _sstl_record_container_stats(this);
+      sstl_assert(!empty());
+      _last_pointer->~value_type();
+      _last_pointer = _wrap(_offset(_last_pointer) + CAPACITY - 1);
+      --_size;
+   }
+
+   void pop_front()
+      _sstl_noexcept(std::is_nothrow_destructible<value_type>::value)
+   {
+      _sstl_record_container_stats(this);
+      sstl_assert(!empty());
+      _first_pointer->~value_type();
+      _first_pointer = _wrap(_offset(_first_pointer) + 1);
+      --_size;
+   }
+
+private:
+   //the slot after the last element is either free or holds the (trivially destructible) first element,
+   //which doesn't need to be destroyed: the positions are updated without branching on full()
+   template<class... Args>
+   void _emplace_back_overwrite(std::true_type, Args&&... args)
+      _sstl_noexcept(std::is_nothrow_constructible<value_type, typename std::add_rvalue_reference<Args>::type...>::value)
+   {
+      auto is_full = static_cast<size_type>(_size == CAPACITY);
+      auto new_last_pointer = _wrap(_offset(_last_pointer) + 1);
+      new(new_last_pointer) value_type(std::forward<Args>(args)...);
+      _last_pointer = new_last_pointer;
+      _first_pointer = _wrap(_offset(_first_pointer) + is_full);
+      _size += 1 - is_full;
+   }
+
+   //if the deque is full the new element is constructed before the first one is destroyed,
+   //because the arguments might refer to it (e.g. push_back_overwrite(front())).
+   //If the move of the new element throws, the overwritten first element is lost
+   template<class... Args>
+   void _emplace_back_overwrite(std::false_type, Args&&... args)
+      _sstl_noexcept(std::is_nothrow_constructible<value_type, typename std::add_rvalue_reference<Args>::type...>::value
+                     && std::is_nothrow_move_constructible<value_type>::value
+                     && std::is_nothrow_destructible<value_type>::value)
+   {
+      if(full())
+      {
+         value_type value(std::forward<Args>(args)...);
+         pop_front();
+         emplace_back(std::move(value));
+      }
+      else
+      {
+         emplace_back(std::forward<Args>(args)...);
+      }
+   }
+
+   pointer _storage() _sstl_noexcept_
+   {
+      return static_cast<pointer>(static_cast<void*>(_buffer));
+   }
+
+   size_type _offset(const_pointer ptr) _sstl_noexcept_
+   {
+      return static_cast<size_type>(ptr - _storage());
+   }
+
+   //returns the position of the storage at the specified offset (smaller than twice the capacity)
+   pointer _wrap(size_type offset) _sstl_noexcept_
+   {
+      return _storage() + _wrap_deque_offset<CAPACITY>(offset);
+   }
+
 private:
    size_type _size{ 0 };
    pointer _first_pointer{ _base::_begin_storage() };
    pointer _last_pointer{ _base::_begin_storage() + CAPACITY - 1 };
    pointer _end_storage{ _base::_begin_storage() + CAPACITY };
+   #if _sstl_has_stats()
+   container_stats _stats;
+   #endif
    typename _aligned_storage<sizeof(value_type), std::alignment_of<value_type>::value>::type _buffer[CAPACITY];
 };
 
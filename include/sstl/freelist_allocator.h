@@ -17,6 +17,7 @@ as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
 #include "__internal/_except.h"
 #include "__internal/_aligned_storage.h"
 #include "__internal/_hacky_derived_class_access.h"
+#include "__internal/_stats.h"
 
 namespace sstl
 {
@@ -41,6 +42,9 @@ public:
       auto new_next_free = *reinterpret_cast<void**>(_sstl_member_of_derived_class(this, _next_free));
       auto ret = static_cast<pointer>(_sstl_member_of_derived_class(this, _next_free));
       _sstl_member_of_derived_class(this, _next_free) = new_next_free;
+      #if _sstl_has_stats()
+      _record_allocation(_sstl_member_of_derived_class(this, _stats));
+      #endif
       return ret;
    }
 
@@ -48,6 +52,9 @@ public:
    {
       *reinterpret_cast<void**>(p) = _sstl_member_of_derived_class(this, _next_free);
       _sstl_member_of_derived_class(this, _next_free) = p;
+      #if _sstl_has_stats()
+      _record_deallocation(_sstl_member_of_derived_class(this, _stats));
+      #endif
    }
 
    bool full() const
@@ -55,6 +62,13 @@ public:
       return _sstl_member_of_derived_class(this, _next_free) == nullptr;
    }
 
+   #if _sstl_has_stats()
+   const allocator_stats& stats() const _sstl_noexcept_
+   {
+      return _sstl_member_of_derived_class(this, _stats);
+   }
+   #endif
+
 protected:
    using _type_for_hacky_derived_class_access = freelist_allocator<T, 11>;
 
@@ -110,6 +124,9 @@ private:
 
 private:
    void* _next_free{ _pool };
+   #if _sstl_has_stats()
+   allocator_stats _stats;
+   #endif
    typename _aligned_storage<_pool_block_size, _pool_block_align>::type _pool[CAPACITY];
 };
 
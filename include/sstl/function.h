@@ -9,11 +9,12 @@ as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
 #define _SSTL_FUNCTION__
 
 #include <cstddef>
+#include <cstring>
 #include <type_traits>
-#include <algorithm>
 #include <new>
 #include <memory>
 #include "__internal/_utility.h"
+#include "__internal/_metaprog.h"
 #include "__internal/_except.h"
 #include "__internal/_hacky_derived_class_access.h"
 
@@ -23,22 +24,31 @@ namespace sstl
 template<class TTarget, size_t CALLABLE_SIZE=static_cast<size_t>(-1)>
 class function;
 
+template<class TSignature>
+class function_ref;
+
 namespace _detail
 {
+   // type of the parameters forwarded to the target. Small (up to two words) trivially copyable
+   // values are forwarded by value, so that they can be passed in registers (e.g. integers, floating
+   // points, pairs of pointers), the other values by const reference, thus avoiding further copies
    template<class T>
-   struct _make_const_ref_if_value
+   struct _forwarded_parameter
    {
-      using type = const T&;
+      using type = typename std::conditional<
+         std::is_trivially_copyable<T>::value && sizeof(T) <= 2*sizeof(void*),
+         T,
+         const T&>::type;
    };
 
    template<class T>
-   struct _make_const_ref_if_value<T&>
+   struct _forwarded_parameter<T&>
    {
       using type = T&;
    };
 
    template<class T>
-   struct _make_const_ref_if_value<T&&>
+   struct _forwarded_parameter<T&&>
    {
       using type = T&&;
    };
@@ -90,6 +100,31 @@ namespace _detail
          && _detail::_are_convertible<std::tuple<TParamsFrom...>, std::tuple<TParamsTo...>>::value;
    };
 
+   // true if the template parameter is sstl::function with the specified signature (any callable size)
+   template<class T, class TSignature>
+   struct _is_function_with_signature : std::is_base_of<sstl::function<TSignature>, T> {};
+
+   // sstl::function with the signature of "TFunction" (a sstl::function) that fits, as a target,
+   // in the buffer of a sstl::function with the specified callable size. The target of a function with
+   // different (but compatible) signature is stored in such a function, i.e. it is invoked through
+   // a thunk of the new signature that converts the parameters and the return value
+   template<class TFunction, size_t CALLABLE_SIZE>
+   struct _converted_function_target;
+
+   template<class TResult, class... TParams, size_t SIZE, size_t CALLABLE_SIZE>
+   struct _converted_function_target<sstl::function<TResult(TParams...), SIZE>, CALLABLE_SIZE>
+   {
+   private:
+      using _smallest = sstl::function<TResult(TParams...), 1>;
+      static const size_t _alignment = std::alignment_of<_smallest>::value;
+      static const size_t _header_size = sizeof(_smallest) - _alignment;
+      static const size_t _aligned_callable_size = CALLABLE_SIZE / _alignment * _alignment;
+
+   public:
+      using type = sstl::function<TResult(TParams...),
+         _metaprog::max<_aligned_callable_size, _header_size + _alignment>::value - _header_size>;
+   };
+
    template<class T>
    T& _get_reference(T* p) _sstl_noexcept_ { return *p; }
 
@@ -99,12 +134,64 @@ namespace _detail
 
 namespace _detail
 {
-   template<class T, class=void>
-   struct _is_inheritable
+   // operations on a target stored in the buffer of sstl::function (one static table per target type).
+   // The invocation isn't part of the table: its pointer is stored in the function itself.
+   // The operations of trivial targets (see below) are null pointers:
+   // such targets are copied and moved with a memcpy and their destruction is a no-op
+   struct _function_target_ops
+   {
+      void (*copy_construct)(const void* source, void* destination);
+      void (*move_construct)(void* source, void* destination);
+      void (*destroy)(void* target);
+      size_t size;
+   };
+
+   // true if the target can be copied and moved with a memcpy and needs no destruction.
+   // Not std::is_trivially_copyable, which also holds for targets whose copy constructor is deleted
+   template<class TTarget>
+   struct _is_trivial_function_target : std::integral_constant<bool,
+      std::is_trivially_copy_constructible<TTarget>::value
+      && std::is_trivially_move_constructible<TTarget>::value
+      && std::is_trivially_destructible<TTarget>::value> {};
+
+   template<class TTarget, bool IS_TRIVIAL = _is_trivial_function_target<TTarget>::value>
+   struct _function_target_ops_for
    {
-      // FIXME: fix with "&& !std::is_final<T>::value" as soon as C++14 support is available
-      static const bool value = std::is_class<T>::value;
+      static void _copy_construct(const void* source, void* destination)
+      {
+         new(destination) TTarget(*static_cast<const TTarget*>(source));
+      }
+
+      static void _move_construct(void* source, void* destination)
+      {
+         new(destination) TTarget(std::move(*static_cast<TTarget*>(source)));
+      }
+
+      static void _destroy(void* target) _sstl_noexcept_
+      {
+         static_cast<TTarget*>(target)->~TTarget();
+      }
+
+      static const _function_target_ops value;
+   };
+
+   template<class TTarget, bool IS_TRIVIAL>
+   const _function_target_ops _function_target_ops_for<TTarget, IS_TRIVIAL>::value =
+   {
+      &_function_target_ops_for<TTarget, IS_TRIVIAL>::_copy_construct,
+      &_function_target_ops_for<TTarget, IS_TRIVIAL>::_move_construct,
+      &_function_target_ops_for<TTarget, IS_TRIVIAL>::_destroy,
+      sizeof(TTarget)
    };
+
+   template<class TTarget>
+   struct _function_target_ops_for<TTarget, true>
+   {
+      static const _function_target_ops value;
+   };
+
+   template<class TTarget>
+   const _function_target_ops _function_target_ops_for<TTarget, true>::value = { nullptr, nullptr, nullptr, sizeof(TTarget) };
 }
 
 namespace _detail
@@ -113,16 +200,55 @@ namespace _detail
    struct _is_member_function_pointer_compatible;
 
    template<class TPointerRet, class TPointerClass, class... TPointerParams,
-            class TFunctionRet, class TFirstFunctionParam, class... TOtherFunctionParams, size_t SIZE>
+            class TFunctionRet, class TFirstFunctionParam, class... TOtherFunctionParams>
    struct _is_member_function_pointer_compatible<
       TPointerRet (TPointerClass::*) (TPointerParams...),
-      sstl::function<TFunctionRet(TFirstFunctionParam, TOtherFunctionParams...), SIZE>>
+      TFunctionRet(TFirstFunctionParam, TOtherFunctionParams...)>
    {
       static const bool value =
          std::is_same<TPointerClass*, TFirstFunctionParam>::value || std::is_same<TPointerClass&, TFirstFunctionParam>::value;
    };
 }
 
+namespace _detail
+{
+   // static thunk that invokes the target stored at the specified address with the specified signature
+   template<class TTarget, class TSignature, class=void>
+   struct _function_target_invoker;
+
+   template<class TTarget, class TResult, class... TParams>
+   struct _function_target_invoker<TTarget, TResult(TParams...),
+                                   typename std::enable_if<!std::is_member_function_pointer<TTarget>::value>::type>
+   {
+      static TResult _invoke(void* target, typename _forwarded_parameter<TParams>::type... params)
+      {
+         return (*static_cast<TTarget*>(target))(std::forward<typename _forwarded_parameter<TParams>::type>(params)...);
+      }
+   };
+
+   //member function pointer specialization
+   template<class TTarget, class TResult, class... TParams>
+   struct _function_target_invoker<TTarget, TResult(TParams...),
+                                   typename std::enable_if<std::is_member_function_pointer<TTarget>::value>::type>
+   {
+      static TResult _invoke(void* target, typename _forwarded_parameter<TParams>::type... params)
+      {
+         return _invoke_member_function(*static_cast<TTarget*>(target),
+                                        std::forward<typename _forwarded_parameter<TParams>::type>(params)...);
+      }
+
+      template<class TInstance, class... TMemberFunctionParams>
+      static TResult _invoke_member_function(TTarget target, TInstance instance, TMemberFunctionParams&&... params)
+      {
+         return (_get_reference(instance).*target)(std::forward<TMemberFunctionParams>(params)...);
+      }
+
+      static_assert(_is_member_function_pointer_compatible<TTarget, TResult(TParams...)>::value,
+         "attempted to assign an incompatible member function pointer."
+         " Are the types of the first (left most) parameters compatible?");
+   };
+}
+
 template<class TResult, class... TParams>
 class function<TResult(TParams...)>
 {
@@ -130,6 +256,10 @@ class function<TResult(TParams...)>
    template<class, size_t>
    friend class function;
 
+   //friend declaration required to reference the target
+   template<class>
+   friend class function_ref;
+
 public:
    //required because gcc-arm-none-eabi 4.9 might not consider the forwarding-reference overload as candidate
    function& operator=(const function& rhs)
@@ -158,9 +288,10 @@ public:
       return *this;
    }
 
-   TResult operator()(typename _detail::_make_const_ref_if_value<TParams>::type... params) const
+   TResult operator()(typename _detail::_forwarded_parameter<TParams>::type... params) const
    {
-      return _get_internal_callable()._call(std::forward<typename _detail::_make_const_ref_if_value<TParams>::type>(params)...);
+      return _sstl_member_of_derived_class(this, _invoker)(
+         _target(), std::forward<typename _detail::_forwarded_parameter<TParams>::type>(params)...);
    }
 
    operator bool() const _sstl_noexcept_
@@ -171,202 +302,147 @@ public:
 protected:
    using _type_for_hacky_derived_class_access = function<TResult(TParams...), 0>;
 
-   struct _internal_callable
-   {
-      virtual ~_internal_callable() {}
-      virtual TResult _call(typename _detail::_make_const_ref_if_value<TParams>::type...) = 0;
-      // std::true_type -> copy construction
-      void _construct_to_buffer(std::true_type, void* buffer) const
-      {
-         _copy_construct_to_buffer(buffer);
-      }
-      // std::false_type -> move construction
-      void _construct_to_buffer(std::false_type, void* buffer)
-      {
-         _move_construct_to_buffer(buffer);
-      }
-      virtual void _copy_construct_to_buffer(void*) const = 0;
-      virtual void _move_construct_to_buffer(void*) = 0;
-      virtual size_t _size() = 0;
-   };
-
-   template<class, class=void>
-   struct _internal_callable_imp;
+   using _invoker_type = TResult(*)(void*, typename _detail::_forwarded_parameter<TParams>::type...);
 
-   //EBO specialization
-   template<class TTarget>
-   struct _internal_callable_imp<TTarget, typename std::enable_if<_detail::_is_inheritable<TTarget>::value>::type >
-      : _internal_callable, TTarget
+   //the invoker of an invalid function is a null pointer (sentinel), i.e. the check is O(1)
+   bool _is_internal_callable_valid() const _sstl_noexcept_
    {
-      template<class T>
-      _internal_callable_imp(T&& target) : TTarget(std::forward<T>(target))
-      {
-      }
-
-      TResult _call(typename _detail::_make_const_ref_if_value<TParams>::type... params) override
-      {
-         return (*this)(std::forward<typename _detail::_make_const_ref_if_value<TParams>::type>(params)...);
-      }
-
-      void _copy_construct_to_buffer(void* b) const override
-      {
-         new(b) _internal_callable_imp(static_cast<const TTarget&>(*this));
-      }
-
-      void _move_construct_to_buffer(void* b) override
-      {
-         new(b) _internal_callable_imp(std::move(static_cast<TTarget&>(*this)));
-      }
-
-      size_t _size() override
-      {
-         return sizeof(_internal_callable_imp);
-      }
-   };
+      return _sstl_member_of_derived_class(this, _invoker) != nullptr;
+   }
 
-   //member function pointer specialization
-   template<class TTarget>
-   struct _internal_callable_imp<TTarget, typename std::enable_if<std::is_member_function_pointer<TTarget>::value>::type >
-      : _internal_callable
+   void* _target() const _sstl_noexcept_
    {
-      template<class T>
-      _internal_callable_imp(T&& target) : target(target)
-      {
-      }
-
-      TResult _call(typename _detail::_make_const_ref_if_value<TParams>::type... params) override
-      {
-         return _call_member_function(std::forward<typename _detail::_make_const_ref_if_value<TParams>::type>(params)...);
-      }
-
-      template<class TInstance, class... TMemberFunctionParams>
-      TResult _call_member_function(TInstance instance, TMemberFunctionParams&&... params)
-      {
-         return (_detail::_get_reference(instance).*target)(std::forward<TMemberFunctionParams>(params)...);
-      }
-
-      void _copy_construct_to_buffer(void* b) const override
-      {
-         new(b) _internal_callable_imp(target);
-      }
-
-      void _move_construct_to_buffer(void* b) override
-      {
-         new(b) _internal_callable_imp(target);
-      }
-
-      size_t _size() override
-      {
-         return sizeof(_internal_callable_imp);
-      }
-
-      TTarget target;
-
-      static_assert(_detail::_is_member_function_pointer_compatible<TTarget, function>::value,
-         "attempted to assign an incompatible member function pointer."
-         " Are the types of the first (left most) parameters compatible?");
-   };
-
-   template<class TTarget>
-   struct _internal_callable_imp<TTarget,
-                                 typename std::enable_if<
-                                    !_detail::_is_inheritable<TTarget>::value
-                                    && !std::is_member_function_pointer<TTarget>::value>::type>
-      : _internal_callable
-   {
-      template<class T>
-      _internal_callable_imp(T&& target) : target(std::forward<T>(target))
-      {
-      }
-
-      TResult _call(typename _detail::_make_const_ref_if_value<TParams>::type... params) override
-      {
-         return target(std::forward<typename _detail::_make_const_ref_if_value<TParams>::type>(params)...);
-      }
-
-      void _copy_construct_to_buffer(void* b) const override
-      {
-         new(b) _internal_callable_imp(target);
-      }
-
-      void _move_construct_to_buffer(void* b) override
-      {
-         new(b) _internal_callable_imp(std::move(target));
-      }
-
-      size_t _size() override
-      {
-         return sizeof(_internal_callable_imp);
-      }
-
-      TTarget target;
-   };
+      return _sstl_member_of_derived_class(this, _buffer);
+   }
 
-protected:
-   bool _is_internal_callable_valid() const _sstl_noexcept_
+   _invoker_type _get_invoker() const _sstl_noexcept_
    {
-      return std::any_of(
-         _sstl_member_of_derived_class(this, _buffer),
-         _sstl_member_of_derived_class(this, _buffer) + _sstl_member_of_derived_class(this, _buffer_size),
-         [](uint8_t c){ return c != 0; });
+      return _sstl_member_of_derived_class(this, _invoker);
    }
 
-   _internal_callable& _get_internal_callable() const _sstl_noexcept_
+   const _detail::_function_target_ops* _get_target_ops() const _sstl_noexcept_
    {
-      auto non_const_buffer = const_cast<void*>(static_cast<const void*>(_sstl_member_of_derived_class(this, _buffer)));
-      return *static_cast<_internal_callable*>(non_const_buffer);
+      return _sstl_member_of_derived_class(this, _ops);
    }
 
    template<class T, class TTarget = typename std::decay<T>::type>
    void _construct_internal_callable(T&& rhs, typename std::enable_if<_detail::_is_function<TTarget>::value>::type* = nullptr)
    {
-      if(rhs._is_internal_callable_valid())
+      //the callable size isn't known here, i.e. a function with different signature can only be
+      //assigned to the derived class (see _converted_function_target)
+      static_assert(_detail::_is_function_with_signature<TTarget, TResult(TParams...)>::value,
+         "attempted to assign a sstl::function with different signature through a base class reference."
+         " Hint: assign it to the derived class (the one with the callable size).");
+      auto trivial_copy_size = rhs._is_internal_callable_valid() ? rhs._get_target_ops()->size : 0;
+      _construct_internal_callable_from_function(std::forward<T>(rhs), trivial_copy_size);
+   }
+
+   //a trivial target is copied with a memcpy of "trivial_copy_size" bytes, i.e. a fixed-size memcpy
+   //of the whole buffer if the size of rhs' buffer is known at compile time
+   template<class T>
+   void _construct_internal_callable_from_function(T&& rhs, size_t trivial_copy_size)
+   {
+      auto ops = rhs._get_target_ops();
+      if(ops == nullptr)
       {
-         using is_copy_construction = std::is_lvalue_reference<T>;
-         rhs._get_internal_callable()._construct_to_buffer(is_copy_construction{}, _sstl_member_of_derived_class(this, _buffer));
+         _invalidate_internal_callable();
+         return;
       }
+      if(ops->copy_construct == nullptr)
+         std::memcpy(_target(), rhs._target(), trivial_copy_size);
       else
+         _construct_target(std::is_lvalue_reference<T>{}, *ops, rhs._target());
+      _sstl_member_of_derived_class(this, _invoker) = rhs._get_invoker();
+      _sstl_member_of_derived_class(this, _ops) = ops;
+   }
+
+   //the function with different signature is stored as target (an invalid one leaves this function invalid)
+   template<class TConverted, class T>
+   void _construct_internal_callable_from_converted_function(T&& rhs)
+   {
+      if(!rhs._is_internal_callable_valid())
       {
          _invalidate_internal_callable();
+         return;
       }
+      //if assertion fails specify a larger callable size (template parameter)
+      sstl_assert(sizeof(TConverted) <= _sstl_member_of_derived_class(this, _buffer_size));
+      new(_target()) TConverted(std::forward<T>(rhs));
+      _sstl_member_of_derived_class(this, _invoker) = &_detail::_function_target_invoker<TConverted, TResult(TParams...)>::_invoke;
+      _sstl_member_of_derived_class(this, _ops) = &_detail::_function_target_ops_for<TConverted>::value;
    }
 
    template<class T, class TTarget = typename std::decay<T>::type>
    void _construct_internal_callable(T&& rhs, typename std::enable_if<!_detail::_is_function<TTarget>::value>::type* = nullptr)
    {
-      new(_sstl_member_of_derived_class(this, _buffer)) _internal_callable_imp<TTarget>(std::forward<T>(rhs));
+      static_assert(std::is_copy_constructible<TTarget>::value,
+         "attempted to assign a target that isn't copy constructible."
+         " Hint: use sstl::unique_function for move-only targets.");
+      new(_target()) TTarget(std::forward<T>(rhs));
+      _sstl_member_of_derived_class(this, _invoker) = &_detail::_function_target_invoker<TTarget, TResult(TParams...)>::_invoke;
+      _sstl_member_of_derived_class(this, _ops) = &_detail::_function_target_ops_for<TTarget>::value;
+   }
+
+   // std::true_type -> copy construction
+   void _construct_target(std::true_type, const _detail::_function_target_ops& ops, void* source)
+   {
+      ops.copy_construct(source, _target());
+   }
+
+   // std::false_type -> move construction
+   void _construct_target(std::false_type, const _detail::_function_target_ops& ops, void* source)
+   {
+      ops.move_construct(source, _target());
    }
 
+   //if the construction of the new target throws, the function is left invalid
    template<class T>
    void _assign_internal_callable(T&& rhs)
    {
-      //omit self check in case of move assignment (self move assignment is UB)
-      if(   std::is_lvalue_reference<T>::value 
-         && static_cast<const void*>(this) == reinterpret_cast<const void*>(std::addressof(rhs)))
+      if(_is_self_assignment(rhs))
          return;
-      if(_is_internal_callable_valid())
-         _get_internal_callable().~_internal_callable();
-      #if _sstl_has_exceptions()
-      try
-      {
-      #endif
-         _construct_internal_callable(std::forward<T>(rhs));
-      #if _sstl_has_exceptions()
-      }
-      catch(...)
-      {
-         _invalidate_internal_callable();
-         throw;
-      }
-      #endif
+      _destroy_internal_callable();
+      _invalidate_internal_callable();
+      _construct_internal_callable(std::forward<T>(rhs));
+   }
+
+   template<class T>
+   void _assign_internal_callable_from_function(T&& rhs, size_t trivial_copy_size)
+   {
+      if(_is_self_assignment(rhs))
+         return;
+      _destroy_internal_callable();
+      _invalidate_internal_callable();
+      _construct_internal_callable_from_function(std::forward<T>(rhs), trivial_copy_size);
+   }
+
+   template<class TConverted, class T>
+   void _assign_internal_callable_from_converted_function(T&& rhs)
+   {
+      _destroy_internal_callable();
+      _invalidate_internal_callable();
+      _construct_internal_callable_from_converted_function<TConverted>(std::forward<T>(rhs));
+   }
+
+   //omit self check in case of move assignment (self move assignment is UB)
+   template<class T>
+   bool _is_self_assignment(T&& rhs) const _sstl_noexcept_
+   {
+      return std::is_lvalue_reference<T>::value
+             && static_cast<const void*>(this) == reinterpret_cast<const void*>(std::addressof(rhs));
+   }
+
+   void _destroy_internal_callable() _sstl_noexcept_
+   {
+      auto ops = _get_target_ops();
+      if(ops != nullptr && ops->destroy != nullptr)
+         ops->destroy(_target());
    }
    
    void _invalidate_internal_callable() _sstl_noexcept_
    {
-      std::fill(
-         _sstl_member_of_derived_class(this, _buffer),
-         _sstl_member_of_derived_class(this, _buffer) + _sstl_member_of_derived_class(this, _buffer_size),
-         0);
+      _sstl_member_of_derived_class(this, _invoker) = nullptr;
+      _sstl_member_of_derived_class(this, _ops) = nullptr;
    }
    
    template<class T, class TTarget = typename std::decay<T>::type>
@@ -374,14 +450,14 @@ protected:
    {
       //if assertion fails specify a larger callable size (template parameter)
       sstl_assert(!rhs._is_internal_callable_valid()
-                  || rhs._get_internal_callable()._size() <= _sstl_member_of_derived_class(this, _buffer_size));
+                  || rhs._get_target_ops()->size <= _sstl_member_of_derived_class(this, _buffer_size));
    }
 
    template<class T, class TTarget = typename std::decay<T>::type>
    void _runtime_assert_buffer_can_contain_target(const T&, typename std::enable_if<!_detail::_is_function<TTarget>::value>::type* = nullptr) _sstl_noexcept_
    {
       //if assertion fails specify a larger callable size (template parameter)
-      sstl_assert(sizeof(_internal_callable_imp<TTarget>) <= _sstl_member_of_derived_class(this, _buffer_size));
+      sstl_assert(sizeof(TTarget) <= _sstl_member_of_derived_class(this, _buffer_size));
    }
    
 protected:
@@ -400,7 +476,6 @@ class function<TResult(TParams...), CALLABLE_SIZE> final : public function<TResu
 private:
    using _base = function<TResult(TParams...)>;
    using _type_for_hacky_derived_class_access = typename _base::_type_for_hacky_derived_class_access;
-   using _internal_callable = typename _base::_internal_callable;
 
 public:
    function() _sstl_noexcept_
@@ -413,16 +488,14 @@ public:
    function(const function& rhs)
    {
       _assert_hacky_derived_class_access_is_valid<_base, function, _type_for_hacky_derived_class_access>();
-      _assert_buffer_can_contain_target(rhs);
-      _base::_construct_internal_callable(rhs);
+      _base::_construct_internal_callable_from_function(rhs, _trivial_copy_size(rhs));
    }
 
    //required because gcc-arm-none-eabi 4.9 might not consider the forwarding-reference overload as candidate
    function(function&& rhs)
    {
       _assert_hacky_derived_class_access_is_valid<_base, function, _type_for_hacky_derived_class_access>();
-      _assert_buffer_can_contain_target(rhs);
-      _base::_construct_internal_callable(std::move(rhs));
+      _base::_construct_internal_callable_from_function(std::move(rhs), _trivial_copy_size(rhs));
    }
 
    template<class T, class TTarget = typename std::decay<T>::type>
@@ -430,7 +503,7 @@ public:
    {
       _assert_hacky_derived_class_access_is_valid<_base, function, _type_for_hacky_derived_class_access>();
       _assert_buffer_can_contain_target(rhs);
-      _base::_construct_internal_callable(std::forward<T>(rhs));
+      _construct_from_function(std::forward<T>(rhs), _detail::_is_function_with_signature<TTarget, TResult(TParams...)>{});
    }
 
    template<class T, class TTarget = typename std::decay<T>::type>
@@ -446,16 +519,14 @@ public:
    //required because gcc-arm-none-eabi 4.9 might not consider the forwarding-reference overload as candidate
    function& operator=(const function& rhs)
    {
-      _assert_buffer_can_contain_target(rhs);
-      _base::_assign_internal_callable(rhs);
+      _base::_assign_internal_callable_from_function(rhs, _trivial_copy_size(rhs));
       return *this;
    }
 
    //required because gcc-arm-none-eabi 4.9 might not consider the forwarding-reference overload as candidate
    function& operator=(function&& rhs)
    {
-      _assert_buffer_can_contain_target(rhs);
-      _base::_assign_internal_callable(std::move(rhs));
+      _base::_assign_internal_callable_from_function(std::move(rhs), _trivial_copy_size(rhs));
       return *this;
    }
 
@@ -466,19 +537,72 @@ public:
                      || (!std::is_lvalue_reference<T>::value && std::is_nothrow_move_constructible<TTarget>::value)))
    {
       _assert_buffer_can_contain_target(rhs);
-      _base::_assign_internal_callable(std::forward<T>(rhs));
+      _assign(std::forward<T>(rhs), _detail::_is_function<TTarget>{});
       return *this;
    }
 
    ~function()
    {
-      if(_base::_is_internal_callable_valid())
-      {
-         _base::_get_internal_callable().~_internal_callable();
-      }
+      _base::_destroy_internal_callable();
    }
 
 private:
+   // std::true_type -> rhs is a sstl::function
+   template<class T, class TTarget = typename std::decay<T>::type>
+   void _assign(T&& rhs, std::true_type)
+   {
+      _assign_from_function(std::forward<T>(rhs), _detail::_is_function_with_signature<TTarget, TResult(TParams...)>{});
+   }
+
+   // std::false_type -> rhs is any other target
+   template<class T>
+   void _assign(T&& rhs, std::false_type)
+   {
+      _base::_assign_internal_callable(std::forward<T>(rhs));
+   }
+
+   // std::true_type -> rhs is a sstl::function with the same signature
+   template<class T>
+   void _construct_from_function(T&& rhs, std::true_type)
+   {
+      _base::_construct_internal_callable_from_function(std::forward<T>(rhs), _trivial_copy_size(rhs));
+   }
+
+   // std::false_type -> rhs is a sstl::function with different (but compatible) signature
+   template<class T, class TTarget = typename std::decay<T>::type>
+   void _construct_from_function(T&& rhs, std::false_type)
+   {
+      using converted_type = typename _detail::_converted_function_target<TTarget, CALLABLE_SIZE>::type;
+      _base::template _construct_internal_callable_from_converted_function<converted_type>(std::forward<T>(rhs));
+   }
+
+   // std::true_type -> rhs is a sstl::function with the same signature
+   template<class T>
+   void _assign_from_function(T&& rhs, std::true_type)
+   {
+      _base::_assign_internal_callable_from_function(std::forward<T>(rhs), _trivial_copy_size(rhs));
+   }
+
+   // std::false_type -> rhs is a sstl::function with different (but compatible) signature
+   template<class T, class TTarget = typename std::decay<T>::type>
+   void _assign_from_function(T&& rhs, std::false_type)
+   {
+      using converted_type = typename _detail::_converted_function_target<TTarget, CALLABLE_SIZE>::type;
+      _base::template _assign_internal_callable_from_converted_function<converted_type>(std::forward<T>(rhs));
+   }
+
+   //a trivial target of a function of the same type is copied with a fixed-size memcpy of the whole buffer
+   static size_t _trivial_copy_size(const function&) _sstl_noexcept_
+   {
+      return sizeof(_buffer);
+   }
+
+   template<class T>
+   static size_t _trivial_copy_size(const T& rhs) _sstl_noexcept_
+   {
+      return rhs._is_internal_callable_valid() ? rhs._get_target_ops()->size : 0;
+   }
+
    template<class T, class TTarget = typename std::decay<T>::type>
    void _assert_buffer_can_contain_target(const T& rhs, typename std::enable_if<_detail::_is_function<TTarget>::value>::type* = nullptr) _sstl_noexcept_
    {
@@ -488,15 +612,17 @@ private:
    template<class T, class TTarget = typename std::decay<T>::type>
    void _assert_buffer_can_contain_target(const T&, typename std::enable_if<!_detail::_is_function<TTarget>::value>::type* = nullptr) _sstl_noexcept_
    {
-      static_assert(sizeof(typename _base::template _internal_callable_imp<TTarget>) <= sizeof(_buffer),
+      static_assert(sizeof(TTarget) <= sizeof(_buffer),
          "Not enough memory available to store the wished target."
          " Hint: specify a larger callable size (template parameter).");
    }
 
 private:
-   static const size_t _VPTR_SIZE = sizeof(void*);
+   typename _base::_invoker_type _invoker;
+   const _detail::_function_target_ops* _ops;
    size_t _buffer_size{ sizeof(_buffer) };
-   mutable uint8_t _buffer[_VPTR_SIZE + CALLABLE_SIZE];
+   //at least one byte, so that empty targets (e.g. closures without captures) fit
+   mutable uint8_t _buffer[_metaprog::max<CALLABLE_SIZE, 1>::value];
 };
 
 }
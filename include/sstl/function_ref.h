@@ -0,0 +1,108 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#ifndef _SSTL_FUNCTION_REF__
+#define _SSTL_FUNCTION_REF__
+
+#include <type_traits>
+#include <utility>
+#include <memory>
+#include <sstl_assert.h>
+
+#include "__internal/_except.h"
+#include "function.h"
+
+namespace sstl
+{
+
+namespace _detail
+{
+   // true if the template parameter is a function or a pointer to function
+   template<class T>
+   struct _is_function_or_function_pointer
+      : std::integral_constant<bool, std::is_function<typename std::remove_pointer<T>::type>::value> {};
+}
+
+//non-owning reference to a callable (two pointers, no copies of the callable), meant to
+//pass callbacks that are used only for the duration of a call.
+//The referenced callable must outlive the function_ref. A sstl::function with the same signature
+//is referenced through its target, i.e. the call is a single indirect call, but then the function
+//must also not be assigned while referenced. Pointers to member functions are not supported
+template<class TResult, class... TParams>
+class function_ref<TResult(TParams...)>
+{
+private:
+   using _invoker_type = TResult(*)(void*, typename _detail::_forwarded_parameter<TParams>::type...);
+
+public:
+   function_ref(const function<TResult(TParams...)>& rhs) _sstl_noexcept_
+      : _object(rhs._target())
+      , _invoker(rhs._get_invoker())
+   {
+      //if assertion fails the referenced sstl::function has no target
+      sstl_assert(static_cast<bool>(rhs));
+   }
+
+   template<class T, class TCallable = typename std::decay<T>::type,
+            class = typename std::enable_if<
+               !std::is_same<TCallable, function_ref>::value
+               && !_detail::_is_function_with_signature<TCallable, TResult(TParams...)>::value>::type>
+   function_ref(T&& rhs) _sstl_noexcept_
+   {
+      _bind(rhs, _detail::_is_function_or_function_pointer<TCallable>{});
+   }
+
+   function_ref(const function_ref&) _sstl_noexcept_ = default;
+   function_ref& operator=(const function_ref&) _sstl_noexcept_ = default;
+
+   TResult operator()(typename _detail::_forwarded_parameter<TParams>::type... params) const
+   {
+      return _invoker(_object, std::forward<typename _detail::_forwarded_parameter<TParams>::type>(params)...);
+   }
+
+private:
+   // std::true_type -> function or pointer to function
+   //(pointers to functions are converted to pointers to void, which all the supported platforms allow)
+   template<class TFunction>
+   void _bind(TFunction& rhs, std::true_type) _sstl_noexcept_
+   {
+      using function_pointer_type = typename std::decay<TFunction>::type;
+      function_pointer_type function = rhs;
+      //if assertion fails the referenced function pointer is null
+      sstl_assert(function != nullptr);
+      _object = reinterpret_cast<void*>(function);
+      _invoker = &_invoke_function<function_pointer_type>;
+   }
+
+   // std::false_type -> function object
+   template<class TCallable>
+   void _bind(TCallable& rhs, std::false_type) _sstl_noexcept_
+   {
+      _object = const_cast<void*>(static_cast<const void*>(std::addressof(rhs)));
+      _invoker = &_invoke_object<TCallable>;
+   }
+
+   template<class TFunctionPointer>
+   static TResult _invoke_function(void* function, typename _detail::_forwarded_parameter<TParams>::type... params)
+   {
+      return reinterpret_cast<TFunctionPointer>(function)(std::forward<typename _detail::_forwarded_parameter<TParams>::type>(params)...);
+   }
+
+   template<class TCallable>
+   static TResult _invoke_object(void* object, typename _detail::_forwarded_parameter<TParams>::type... params)
+   {
+      return (*static_cast<TCallable*>(object))(std::forward<typename _detail::_forwarded_parameter<TParams>::type>(params)...);
+   }
+
+private:
+   void* _object;
+   _invoker_type _invoker;
+};
+
+}
+
+#endif
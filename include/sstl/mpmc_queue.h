@@ -0,0 +1,274 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#ifndef _SSTL_MPMC_QUEUE__
+#define _SSTL_MPMC_QUEUE__
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <atomic>
+#include <thread>
+
+#include <sstl_assert.h>
+
+#include "__internal/_except.h"
+#include "__internal/_aligned_storage.h"
+#include "__internal/_cache_line.h"
+
+namespace sstl
+{
+
+//bounded lock-free queue for any number of producer and consumer threads (D. Vyukov's algorithm).
+//Each slot has a sequence number that tells the producers (consumers) whether the slot
+//is free (used) for the position they are going to claim. The elements are stored in a static
+//buffer, whose slots are padded to the cache line size to avoid false sharing between the threads.
+//The try_ operations don't block, the others spin (and eventually yield) until they succeed.
+//The value type must be nothrow move constructible, since a claimed slot cannot be given back
+template<class T, size_t CAPACITY>
+class mpmc_queue
+{
+   static_assert(CAPACITY > 0, "the capacity must be greater than zero");
+   static_assert(std::is_nothrow_move_constructible<T>::value, "the value type must be nothrow move constructible");
+
+public:
+   using value_type = T;
+   using size_type = size_t;
+   using reference = T&;
+   using const_reference = const T&;
+   using pointer = T*;
+   using const_pointer = const T*;
+
+public:
+   mpmc_queue() _sstl_noexcept_
+   {
+      for(size_type i=0; i<CAPACITY; ++i)
+         new(_slot(i)) _slot_type(i);
+   }
+
+   mpmc_queue(const mpmc_queue&) = delete;
+   mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+   ~mpmc_queue()
+   {
+      auto head = _dequeue_position.load(std::memory_order_relaxed);
+      auto tail = _enqueue_position.load(std::memory_order_relaxed);
+      for(; head!=tail; ++head)
+         _slot(head)->value()->~value_type();
+      for(size_type i=0; i<CAPACITY; ++i)
+         _slot(i)->~_slot_type();
+   }
+
+   bool try_push(const_reference value)
+      _sstl_noexcept(std::is_nothrow_copy_constructible<value_type>::value)
+   {
+      return try_emplace(value);
+   }
+
+   bool try_push(value_type&& value) _sstl_noexcept_
+   {
+      return try_emplace(std::move(value));
+   }
+
+   //the value is constructed before claiming a slot, unless its construction cannot throw
+   template<class... Args>
+   bool try_emplace(Args&&... args)
+      _sstl_noexcept(std::is_nothrow_constructible<value_type, typename std::add_rvalue_reference<Args>::type...>::value)
+   {
+      return _try_emplace(std::is_nothrow_constructible<value_type, typename std::add_rvalue_reference<Args>::type...>{},
+                          std::forward<Args>(args)...);
+   }
+
+   bool try_pop(reference value)
+      _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value)
+   {
+      size_type pos;
+      if(!_claim_used_slot(pos))
+         return false;
+      _pop_from_slot(pos, value);
+      return true;
+   }
+
+   void push(const_reference value)
+      _sstl_noexcept(std::is_nothrow_copy_constructible<value_type>::value)
+   {
+      emplace(value);
+   }
+
+   void push(value_type&& value) _sstl_noexcept_
+   {
+      emplace(std::move(value));
+   }
+
+   template<class... Args>
+   void emplace(Args&&... args)
+      _sstl_noexcept(std::is_nothrow_constructible<value_type, typename std::add_rvalue_reference<Args>::type...>::value)
+   {
+      auto value = value_type(std::forward<Args>(args)...);
+      size_type pos;
+      for(unsigned spins=0; !_claim_free_slot(pos); ++spins)
+         _spin(spins);
+      _push_to_slot(pos, std::move(value));
+   }
+
+   void pop(reference value)
+      _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value)
+   {
+      size_type pos;
+      for(unsigned spins=0; !_claim_used_slot(pos); ++spins)
+         _spin(spins);
+      _pop_from_slot(pos, value);
+   }
+
+   //the size is exact only if the queue isn't modified concurrently
+   bool empty() const _sstl_noexcept_
+   {
+      return size() == 0;
+   }
+
+   size_type size() const _sstl_noexcept_
+   {
+      auto head = _dequeue_position.load(std::memory_order_acquire);
+      auto tail = _enqueue_position.load(std::memory_order_acquire);
+      return tail > head ? tail - head : 0;
+   }
+
+   size_type capacity() const _sstl_noexcept_
+   {
+      return CAPACITY;
+   }
+
+private:
+   //a slot is free for the producer claiming position "pos" if its sequence number is "pos",
+   //and used for the consumer claiming position "pos" if its sequence number is "pos+1"
+   class _slot_type
+   {
+   public:
+      _slot_type(size_type sequence) _sstl_noexcept_
+         : _sequence(sequence)
+      {}
+
+      pointer value() _sstl_noexcept_
+      {
+         return static_cast<pointer>(static_cast<void*>(&_value));
+      }
+
+      std::atomic<size_type> _sequence;
+
+   private:
+      typename _aligned_storage<sizeof(value_type), std::alignment_of<value_type>::value>::type _value;
+   };
+
+   //the slots start on a cache line boundary and are stored with a stride that is a multiple of the cache line size
+   static const size_type _slot_stride = (sizeof(_slot_type) + _cache_line_size - 1) / _cache_line_size * _cache_line_size;
+   using _slot_storage_type = typename _aligned_storage<_slot_stride, _cache_line_size>::type;
+   static_assert(std::alignment_of<_slot_storage_type>::value == _cache_line_size, "the slots must be aligned to the cache line size");
+
+   template<class... Args>
+   bool _try_emplace(std::true_type, Args&&... args) _sstl_noexcept_
+   {
+      size_type pos;
+      if(!_claim_free_slot(pos))
+         return false;
+      new(_slot(pos)->value()) value_type(std::forward<Args>(args)...);
+      _publish(pos, pos+1);
+      return true;
+   }
+
+   template<class... Args>
+   bool _try_emplace(std::false_type, Args&&... args)
+   {
+      auto value = value_type(std::forward<Args>(args)...);
+      size_type pos;
+      if(!_claim_free_slot(pos))
+         return false;
+      _push_to_slot(pos, std::move(value));
+      return true;
+   }
+
+   void _push_to_slot(size_type pos, value_type&& value) _sstl_noexcept_
+   {
+      new(_slot(pos)->value()) value_type(std::move(value));
+      _publish(pos, pos+1);
+   }
+
+   //if the move assignment throws, the value is lost, but the queue remains consistent
+   void _pop_from_slot(size_type pos, reference value)
+      _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value)
+   {
+      auto element = _slot(pos)->value();
+      auto popped = value_type(std::move(*element));
+      element->~value_type();
+      _publish(pos, pos+CAPACITY);
+      value = std::move(popped);
+   }
+
+   bool _claim_free_slot(size_type& pos) _sstl_noexcept_
+   {
+      return _claim_slot(_enqueue_position, 0, pos);
+   }
+
+   bool _claim_used_slot(size_type& pos) _sstl_noexcept_
+   {
+      return _claim_slot(_dequeue_position, 1, pos);
+   }
+
+   //claims the next position, or returns false if the queue is full (empty)
+   bool _claim_slot(std::atomic<size_type>& position, size_type sequence_offset, size_type& pos) _sstl_noexcept_
+   {
+      pos = position.load(std::memory_order_relaxed);
+      for(;;)
+      {
+         auto sequence = _slot(pos)->_sequence.load(std::memory_order_acquire);
+         auto difference = static_cast<std::intptr_t>(sequence - (pos + sequence_offset));
+         if(difference == 0)
+         {
+            if(position.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed))
+               return true;
+         }
+         else if(difference < 0)
+         {
+            return false;
+         }
+         else
+         {
+            pos = position.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   void _publish(size_type pos, size_type sequence) _sstl_noexcept_
+   {
+      _slot(pos)->_sequence.store(sequence, std::memory_order_release);
+   }
+
+   static void _spin(unsigned spins) _sstl_noexcept_
+   {
+      if(spins >= _spins_before_yield)
+         std::this_thread::yield();
+   }
+
+   //the positions increase monotonically and are wrapped around the buffer only to access the slots
+   _slot_type* _slot(size_type position) _sstl_noexcept_
+   {
+      return static_cast<_slot_type*>(static_cast<void*>(_slots + position % CAPACITY));
+   }
+
+private:
+   static const unsigned _spins_before_yield = 64;
+
+   char _padding0[_cache_line_size];
+   std::atomic<size_type> _enqueue_position{ 0 };
+   char _padding1[_cache_line_size];
+   std::atomic<size_type> _dequeue_position{ 0 };
+   _slot_storage_type _slots[CAPACITY];
+};
+
+}
+
+#endif
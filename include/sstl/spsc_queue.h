@@ -0,0 +1,208 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#ifndef _SSTL_SPSC_QUEUE__
+#define _SSTL_SPSC_QUEUE__
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <atomic>
+#include <algorithm>
+
+#include <sstl_assert.h>
+
+#include "__internal/_except.h"
+#include "__internal/_aligned_storage.h"
+#include "__internal/_cache_line.h"
+
+namespace sstl
+{
+
+//lock-free queue for exactly one producer thread (push operations) and one consumer thread
+//(pop operations). The elements are stored in a static buffer, i.e. the operations neither
+//allocate memory nor make system calls. The push/pop operations don't block: they return
+//false (or the number of transferred elements) if the queue is full/empty
+template<class T, size_t CAPACITY>
+class spsc_queue
+{
+   static_assert(CAPACITY > 0, "the capacity must be greater than zero");
+
+public:
+   using value_type = T;
+   using size_type = size_t;
+   using reference = T&;
+   using const_reference = const T&;
+   using pointer = T*;
+   using const_pointer = const T*;
+
+public:
+   spsc_queue() _sstl_noexcept_ = default;
+   spsc_queue(const spsc_queue&) = delete;
+   spsc_queue& operator=(const spsc_queue&) = delete;
+
+   ~spsc_queue()
+   {
+      auto head = _head.load(std::memory_order_relaxed);
+      auto tail = _tail.load(std::memory_order_relaxed);
+      for(; head!=tail; ++head)
+         _slot(head)->~value_type();
+   }
+
+   //producer operations
+
+   bool try_push(const_reference value)
+      _sstl_noexcept(std::is_nothrow_copy_constructible<value_type>::value)
+   {
+      return try_emplace(value);
+   }
+
+   bool try_push(value_type&& value)
+      _sstl_noexcept(std::is_nothrow_move_constructible<value_type>::value)
+   {
+      return try_emplace(std::move(value));
+   }
+
+   template<class... Args>
+   bool try_emplace(Args&&... args)
+      _sstl_noexcept(std::is_nothrow_constructible<value_type, typename std::add_rvalue_reference<Args>::type...>::value)
+   {
+      auto tail = _tail.load(std::memory_order_relaxed);
+      if(_free_slots(tail, 1) == 0)
+         return false;
+      new(_slot(tail)) value_type(std::forward<Args>(args)...);
+      _tail.store(tail+1, std::memory_order_release);
+      return true;
+   }
+
+   //pushes the elements of the range, up to the free space, and publishes them at once.
+   //Returns the number of pushed elements
+   template<class TIterator>
+   size_type try_push_n(TIterator range_begin, size_type count)
+      _sstl_noexcept(noexcept(value_type(*std::declval<TIterator&>())))
+   {
+      auto tail = _tail.load(std::memory_order_relaxed);
+      count = std::min(count, _free_slots(tail, count));
+      size_type pushed = 0;
+      #if _sstl_has_exceptions()
+      try
+      {
+      #endif
+         for(; pushed<count; ++pushed)
+         {
+            new(_slot(tail+pushed)) value_type(*range_begin);
+            ++range_begin;
+         }
+      #if _sstl_has_exceptions()
+      }
+      catch(...)
+      {
+         while(pushed > 0)
+            _slot(tail + --pushed)->~value_type();
+         throw;
+      }
+      #endif
+      _tail.store(tail+count, std::memory_order_release);
+      return count;
+   }
+
+   //consumer operations
+
+   bool try_pop(reference value)
+      _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value)
+   {
+      return try_pop_n(&value, 1) == 1;
+   }
+
+   //moves up to count elements to the output range and releases their slots at once.
+   //Returns the number of popped elements
+   template<class TOutputIterator>
+   size_type try_pop_n(TOutputIterator out, size_type count)
+      _sstl_noexcept(noexcept(*std::declval<TOutputIterator&>() = std::declval<value_type&&>()))
+   {
+      auto head = _head.load(std::memory_order_relaxed);
+      count = std::min(count, _used_slots(head, count));
+      size_type popped = 0;
+      #if _sstl_has_exceptions()
+      try
+      {
+      #endif
+         for(; popped<count; ++popped)
+         {
+            auto slot = _slot(head+popped);
+            *out = std::move(*slot);
+            ++out;
+            slot->~value_type();
+         }
+      #if _sstl_has_exceptions()
+      }
+      catch(...)
+      {
+         _head.store(head+popped, std::memory_order_release);
+         throw;
+      }
+      #endif
+      _head.store(head+count, std::memory_order_release);
+      return count;
+   }
+
+   //the size is exact only if the queue isn't modified concurrently
+   bool empty() const _sstl_noexcept_
+   {
+      return size() == 0;
+   }
+
+   size_type size() const _sstl_noexcept_
+   {
+      auto head = _head.load(std::memory_order_acquire);
+      return _tail.load(std::memory_order_acquire) - head;
+   }
+
+   size_type capacity() const _sstl_noexcept_
+   {
+      return CAPACITY;
+   }
+
+private:
+   //the producer reloads the consumer's index (and vice versa) only when the cached one indicates
+   //less free (used) slots than required, which saves most of the cache line transfers
+   size_type _free_slots(size_type tail, size_type required) _sstl_noexcept_
+   {
+      if(CAPACITY - (tail - _cached_head) < required)
+         _cached_head = _head.load(std::memory_order_acquire);
+      return CAPACITY - (tail - _cached_head);
+   }
+
+   size_type _used_slots(size_type head, size_type required) _sstl_noexcept_
+   {
+      if(_cached_tail - head < required)
+         _cached_tail = _tail.load(std::memory_order_acquire);
+      return _cached_tail - head;
+   }
+
+   //the indices increase monotonically and are wrapped around the buffer only to access the slots
+   pointer _slot(size_type index) _sstl_noexcept_
+   {
+      return static_cast<pointer>(static_cast<void*>(_buffer + index % CAPACITY));
+   }
+
+private:
+   char _padding0[_cache_line_size];
+   //written by the producer
+   std::atomic<size_type> _tail{ 0 };
+   size_type _cached_head{ 0 };
+   char _padding1[_cache_line_size];
+   //written by the consumer
+   std::atomic<size_type> _head{ 0 };
+   size_type _cached_tail{ 0 };
+   char _padding2[_cache_line_size];
+   typename _aligned_storage<sizeof(value_type), std::alignment_of<value_type>::value>::type _buffer[CAPACITY];
+};
+
+}
+
+#endif
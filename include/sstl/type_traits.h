@@ -0,0 +1,30 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#ifndef _SSTL_TYPE_TRAITS__
+#define _SSTL_TYPE_TRAITS__
+
+#include <type_traits>
+
+namespace sstl
+{
+
+//a type is trivially relocatable if moving an object to a new address and destroying the
+//source is equivalent to copying its bytes (and forgetting the source), i.e. if the object
+//doesn't store pointers to itself nor is registered anywhere by address. The containers
+//use raw memory moves to shift such elements, instead of move-constructions/assignments
+//and destructions. Trivially copyable types are trivially relocatable; other types
+//(e.g. handles with a non-trivial destructor) can opt in by specializing this trait:
+//
+//   namespace sstl { template<> struct is_trivially_relocatable<my_handle> : std::true_type {}; }
+template<class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{};
+
+}
+
+#endif
@@ -0,0 +1,309 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#ifndef _SSTL_UNIQUE_FUNCTION__
+#define _SSTL_UNIQUE_FUNCTION__
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <new>
+#include <utility>
+#include <sstl_assert.h>
+#include "__internal/_metaprog.h"
+#include "__internal/_except.h"
+#include "__internal/_hacky_derived_class_access.h"
+#include "function.h"
+
+namespace sstl
+{
+
+template<class TTarget, size_t CALLABLE_SIZE=static_cast<size_t>(-1)>
+class unique_function;
+
+namespace _detail
+{
+   // true if the template parameter is an instance of sstl::unique_function
+   template<class>
+   struct _is_unique_function : std::false_type {};
+
+   template<class TResult, class... TParams, size_t SIZE>
+   struct _is_unique_function<sstl::unique_function<TResult(TParams...), SIZE>> : std::true_type {};
+}
+
+namespace _detail
+{
+   // operations on a target stored in the buffer of sstl::unique_function: the ones of sstl::function
+   // without the copy construction, i.e. the targets are only required to be move constructible.
+   // As for sstl::function, the operations of trivially copyable targets are null pointers
+   struct _unique_function_target_ops
+   {
+      void (*move_construct)(void* source, void* destination);
+      void (*destroy)(void* target);
+      size_t size;
+   };
+
+   template<class TTarget, bool IS_TRIVIAL = std::is_trivially_copyable<TTarget>::value>
+   struct _unique_function_target_ops_for
+   {
+      static const _unique_function_target_ops value;
+   };
+
+   template<class TTarget, bool IS_TRIVIAL>
+   const _unique_function_target_ops _unique_function_target_ops_for<TTarget, IS_TRIVIAL>::value =
+   {
+      &_function_target_ops_for<TTarget, false>::_move_construct,
+      &_function_target_ops_for<TTarget, false>::_destroy,
+      sizeof(TTarget)
+   };
+
+   template<class TTarget>
+   struct _unique_function_target_ops_for<TTarget, true>
+   {
+      static const _unique_function_target_ops value;
+   };
+
+   template<class TTarget>
+   const _unique_function_target_ops _unique_function_target_ops_for<TTarget, true>::value = { nullptr, nullptr, sizeof(TTarget) };
+}
+
+//move-only sstl::function, i.e. the targets are only required to be move constructible
+//(e.g. function objects that own a unique resource). Moving a unique_function moves its target,
+//the moved-from unique_function is left invalid (the target is owned by a single unique_function)
+template<class TResult, class... TParams>
+class unique_function<TResult(TParams...)>
+{
+   //friend declaration required for derived class' noexcept expressions
+   template<class, size_t>
+   friend class unique_function;
+
+public:
+   unique_function(const unique_function&) = delete;
+   unique_function& operator=(const unique_function&) = delete;
+
+   unique_function& operator=(unique_function&& rhs)
+   {
+      _runtime_assert_buffer_can_contain_target(rhs);
+      _assign_internal_callable_from_unique_function(std::move(rhs), _trivial_move_size(rhs));
+      return *this;
+   }
+
+   template<class T, class TTarget = typename std::decay<T>::type,
+            class = typename std::enable_if<!_detail::_is_unique_function<TTarget>::value>::type>
+   unique_function& operator=(T&& rhs)
+      _sstl_noexcept((std::is_lvalue_reference<T>::value && std::is_nothrow_copy_constructible<TTarget>::value)
+                  || (!std::is_lvalue_reference<T>::value && std::is_nothrow_move_constructible<TTarget>::value))
+   {
+      //if assertion fails specify a larger callable size (template parameter)
+      sstl_assert(sizeof(TTarget) <= _sstl_member_of_derived_class(this, _buffer_size));
+      _assign_internal_callable(std::forward<T>(rhs));
+      return *this;
+   }
+
+   TResult operator()(typename _detail::_forwarded_parameter<TParams>::type... params) const
+   {
+      return _sstl_member_of_derived_class(this, _invoker)(
+         _target(), std::forward<typename _detail::_forwarded_parameter<TParams>::type>(params)...);
+   }
+
+   operator bool() const _sstl_noexcept_
+   {
+      return _is_internal_callable_valid();
+   }
+
+protected:
+   using _type_for_hacky_derived_class_access = unique_function<TResult(TParams...), 0>;
+
+   using _invoker_type = TResult(*)(void*, typename _detail::_forwarded_parameter<TParams>::type...);
+
+   //the invoker of an invalid unique_function is a null pointer (sentinel), i.e. the check is O(1)
+   bool _is_internal_callable_valid() const _sstl_noexcept_
+   {
+      return _sstl_member_of_derived_class(this, _invoker) != nullptr;
+   }
+
+   void* _target() const _sstl_noexcept_
+   {
+      return _sstl_member_of_derived_class(this, _buffer);
+   }
+
+   const _detail::_unique_function_target_ops* _get_target_ops() const _sstl_noexcept_
+   {
+      return _sstl_member_of_derived_class(this, _ops);
+   }
+
+   //a trivial target is moved with a memcpy of "trivial_move_size" bytes, i.e. a fixed-size memcpy
+   //of the whole buffer if the size of rhs' buffer is known at compile time
+   void _construct_internal_callable_from_unique_function(unique_function&& rhs, size_t trivial_move_size)
+   {
+      auto ops = rhs._get_target_ops();
+      if(ops == nullptr)
+      {
+         _invalidate_internal_callable();
+         return;
+      }
+      if(ops->move_construct == nullptr)
+         std::memcpy(_target(), rhs._target(), trivial_move_size);
+      else
+         ops->move_construct(rhs._target(), _target());
+      _sstl_member_of_derived_class(this, _invoker) = _sstl_member_of_derived_class(&rhs, _invoker);
+      _sstl_member_of_derived_class(this, _ops) = ops;
+      rhs._destroy_internal_callable();
+      rhs._invalidate_internal_callable();
+   }
+
+   template<class T, class TTarget = typename std::decay<T>::type>
+   void _construct_internal_callable(T&& rhs)
+   {
+      new(_target()) TTarget(std::forward<T>(rhs));
+      _sstl_member_of_derived_class(this, _invoker) = &_detail::_function_target_invoker<TTarget, TResult(TParams...)>::_invoke;
+      _sstl_member_of_derived_class(this, _ops) = &_detail::_unique_function_target_ops_for<TTarget>::value;
+   }
+
+   //if the construction of the new target throws, the unique_function is left invalid
+   void _assign_internal_callable_from_unique_function(unique_function&& rhs, size_t trivial_move_size)
+   {
+      if(this == &rhs)
+         return;
+      _destroy_internal_callable();
+      _invalidate_internal_callable();
+      _construct_internal_callable_from_unique_function(std::move(rhs), trivial_move_size);
+   }
+
+   template<class T>
+   void _assign_internal_callable(T&& rhs)
+   {
+      _destroy_internal_callable();
+      _invalidate_internal_callable();
+      _construct_internal_callable(std::forward<T>(rhs));
+   }
+
+   void _destroy_internal_callable() _sstl_noexcept_
+   {
+      auto ops = _get_target_ops();
+      if(ops != nullptr && ops->destroy != nullptr)
+         ops->destroy(_target());
+   }
+
+   void _invalidate_internal_callable() _sstl_noexcept_
+   {
+      _sstl_member_of_derived_class(this, _invoker) = nullptr;
+      _sstl_member_of_derived_class(this, _ops) = nullptr;
+   }
+
+   static size_t _trivial_move_size(const unique_function& rhs) _sstl_noexcept_
+   {
+      return rhs._is_internal_callable_valid() ? rhs._get_target_ops()->size : 0;
+   }
+
+   void _runtime_assert_buffer_can_contain_target(const unique_function& rhs) _sstl_noexcept_
+   {
+      //if assertion fails specify a larger callable size (template parameter)
+      sstl_assert(!rhs._is_internal_callable_valid()
+                  || rhs._get_target_ops()->size <= _sstl_member_of_derived_class(this, _buffer_size));
+   }
+
+protected:
+   unique_function() _sstl_noexcept_ = default;
+   unique_function(unique_function&&) _sstl_noexcept_ {} //MSVC (VS2013) does not support default move special member functions
+   ~unique_function() = default;
+};
+
+template<class TResult, class... TParams, size_t CALLABLE_SIZE>
+class unique_function<TResult(TParams...), CALLABLE_SIZE> final : public unique_function<TResult(TParams...)>
+{
+   template<class, size_t >
+   friend class unique_function;
+
+private:
+   using _base = unique_function<TResult(TParams...)>;
+   using _type_for_hacky_derived_class_access = typename _base::_type_for_hacky_derived_class_access;
+
+public:
+   unique_function() _sstl_noexcept_
+   {
+      _assert_hacky_derived_class_access_is_valid<_base, unique_function, _type_for_hacky_derived_class_access>();
+      _base::_invalidate_internal_callable();
+   }
+
+   unique_function(const unique_function&) = delete;
+
+   unique_function(unique_function&& rhs)
+   {
+      _assert_hacky_derived_class_access_is_valid<_base, unique_function, _type_for_hacky_derived_class_access>();
+      _base::_construct_internal_callable_from_unique_function(std::move(rhs), sizeof(_buffer));
+   }
+
+   unique_function(_base&& rhs)
+   {
+      _assert_hacky_derived_class_access_is_valid<_base, unique_function, _type_for_hacky_derived_class_access>();
+      _base::_runtime_assert_buffer_can_contain_target(rhs);
+      _base::_construct_internal_callable_from_unique_function(std::move(rhs), _base::_trivial_move_size(rhs));
+   }
+
+   template<class T, class TTarget = typename std::decay<T>::type,
+            class = typename std::enable_if<!_detail::_is_unique_function<TTarget>::value>::type>
+   unique_function(T&& rhs)
+      _sstl_noexcept((std::is_lvalue_reference<T>::value && std::is_nothrow_copy_constructible<TTarget>::value)
+                  || (!std::is_lvalue_reference<T>::value && std::is_nothrow_move_constructible<TTarget>::value))
+   {
+      _assert_hacky_derived_class_access_is_valid<_base, unique_function, _type_for_hacky_derived_class_access>();
+      _assert_buffer_can_contain_target<TTarget>();
+      _base::_construct_internal_callable(std::forward<T>(rhs));
+   }
+
+   unique_function& operator=(const unique_function&) = delete;
+
+   unique_function& operator=(unique_function&& rhs)
+   {
+      _base::_assign_internal_callable_from_unique_function(std::move(rhs), sizeof(_buffer));
+      return *this;
+   }
+
+   unique_function& operator=(_base&& rhs)
+   {
+      _base::_runtime_assert_buffer_can_contain_target(rhs);
+      _base::_assign_internal_callable_from_unique_function(std::move(rhs), _base::_trivial_move_size(rhs));
+      return *this;
+   }
+
+   template<class T, class TTarget = typename std::decay<T>::type,
+            class = typename std::enable_if<!_detail::_is_unique_function<TTarget>::value>::type>
+   unique_function& operator=(T&& rhs)
+      _sstl_noexcept((std::is_lvalue_reference<T>::value && std::is_nothrow_copy_constructible<TTarget>::value)
+                  || (!std::is_lvalue_reference<T>::value && std::is_nothrow_move_constructible<TTarget>::value))
+   {
+      _assert_buffer_can_contain_target<TTarget>();
+      _base::_assign_internal_callable(std::forward<T>(rhs));
+      return *this;
+   }
+
+   ~unique_function()
+   {
+      _base::_destroy_internal_callable();
+   }
+
+private:
+   template<class TTarget>
+   static void _assert_buffer_can_contain_target() _sstl_noexcept_
+   {
+      static_assert(sizeof(TTarget) <= sizeof(_buffer),
+         "Not enough memory available to store the wished target."
+         " Hint: specify a larger callable size (template parameter).");
+   }
+
+private:
+   typename _base::_invoker_type _invoker;
+   const _detail::_unique_function_target_ops* _ops;
+   size_t _buffer_size{ sizeof(_buffer) };
+   //at least one byte, so that empty targets (e.g. closures without captures) fit
+   mutable uint8_t _buffer[_metaprog::max<CALLABLE_SIZE, 1>::value];
+};
+
+}
+
+#endif
@@ -16,6 +16,8 @@ as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
 #include <algorithm>
 #include <array>
 #include <stdexcept>
+#include <cstring>
+#include <memory>
 
 #include <sstl_assert.h>
 
@@ -25,6 +27,8 @@ as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
 #include "__internal/_aligned_storage.h"
 #include "__internal/_hacky_derived_class_access.h"
 #include "__internal/_debug.h"
+#include "__internal/_stats.h"
+#include "type_traits.h"
 
 namespace sstl
 {
@@ -55,6 +59,7 @@ public:
    vector& operator=(const vector& rhs)
       _sstl_noexcept(noexcept(std::declval<vector>()._copy_assign(std::declval<iterator>(), std::declval<iterator>())))
    {
+      _sstl_record_container_stats(this);
       sstl_assert(rhs.size() <= capacity());
       if(this != &rhs)
       {
@@ -66,6 +71,8 @@ public:
    vector& operator=(vector&& rhs)
       _sstl_noexcept(noexcept(std::declval<vector>()._move_assign(std::declval<iterator>(), std::declval<iterator>())))
    {
+      _sstl_record_container_stats(this);
+      _sstl_record_container_stats(&rhs);
       sstl_assert(rhs.size() <= capacity());
       _move_assign(rhs.begin(), rhs.end());
       _sstl_member_of_derived_class(&rhs, _end_) = rhs.begin();
@@ -77,6 +84,7 @@ public:
             std::declval<std::initializer_list<value_type>>().begin(),
             std::declval<std::initializer_list<value_type>>().end())))
    {
+      _sstl_record_container_stats(this);
       sstl_assert(init.size() <= _sstl_member_of_derived_class(this, _capacity_));
       _copy_assign(init.begin(), init.end());
       return *this;
@@ -85,6 +93,7 @@ public:
    void assign(size_type count, const_reference value)
       _sstl_noexcept(noexcept(std::declval<vector>()._count_assign(std::declval<size_type>(), std::declval<const_reference>())))
    {
+      _sstl_record_container_stats(this);
       sstl_assert(count <= _sstl_member_of_derived_class(this, _capacity_));
       _count_assign(count, value);
    }
@@ -95,6 +104,7 @@ public:
       _sstl_noexcept(noexcept(std::declval<vector>()._copy_assign(std::declval<TIterator>(),
                                                                   std::declval<TIterator>())))
    {
+      _sstl_record_container_stats(this);
       _copy_assign(range_begin, range_end);
    }
 
@@ -103,6 +113,7 @@ public:
          std::declval<std::initializer_list<value_type>>().begin(),
          std::declval<std::initializer_list<value_type>>().end())))
    {
+      _sstl_record_container_stats(this);
       sstl_assert(ilist.size() <= _sstl_member_of_derived_class(this, _capacity_));
       _copy_assign(ilist.begin(), ilist.end());
    }
@@ -262,6 +273,7 @@ public:
 
    void clear() _sstl_noexcept(std::is_nothrow_destructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       auto pos = begin();
       while(pos != end())
          (pos++)->~value_type();
@@ -272,6 +284,7 @@ public:
       _sstl_noexcept(noexcept(std::declval<vector>().template _insert<vector::_is_copy>(  std::declval<iterator>(),
                                                                                           std::declval<reference>())))
    {
+      _sstl_record_container_stats(this);
       sstl_assert(pos >= begin() && pos <= end());
       sstl_assert(size() < capacity());
       return _insert<_is_copy>(const_cast<iterator>(pos), const_cast<reference>(value));
@@ -281,6 +294,7 @@ public:
       _sstl_noexcept(noexcept(std::declval<vector>().template _insert<!vector::_is_copy>( std::declval<iterator>(),
                                                                                           std::declval<reference>())))
    {
+      _sstl_record_container_stats(this);
       sstl_assert(pos >= begin() && pos <= end());
       sstl_assert(size() < capacity());
       return _insert<!_is_copy>(const_cast<iterator>(pos), const_cast<reference>(value));
@@ -292,6 +306,7 @@ public:
                      && std::is_nothrow_copy_constructible<value_type>::value
                      && std::is_nothrow_copy_assignable<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       sstl_assert(pos >= begin() && pos <= end());
       sstl_assert(size() + count <= capacity());
       auto new_end = end() + count;
@@ -356,6 +371,7 @@ public:
                                                                std::declval<TIterator>(),
                                                                std::declval<TIterator>())))
    {
+      _sstl_record_container_stats(this);
       sstl_assert(pos >= begin() && pos <= end());
       sstl_assert(size() + std::distance(range_begin, range_end) <= capacity());
       return _insert(const_cast<iterator>(pos), range_begin, range_end);
@@ -372,6 +388,7 @@ public:
                                           std::declval<iterator>(),
                                           std::declval<iterator>())))
    {
+      _sstl_record_container_stats(this);
       auto nonconst_pos = const_cast<iterator>(pos);
       auto old_end = end();
 
@@ -402,6 +419,7 @@ public:
                                                                std::declval<std::initializer_list<value_type>>().begin(),
                                                                std::declval<std::initializer_list<value_type>>().end())))
    {
+      _sstl_record_container_stats(this);
       sstl_assert(pos >= begin() && pos <= end());
       sstl_assert(size() + init.size() <= capacity());
       return _insert(const_cast<iterator>(pos), init.begin(), init.end());
@@ -413,6 +431,7 @@ public:
                      && noexcept(std::declval<vector>().template _insert<!vector::_is_copy>( std::declval<iterator>(),
                                                                                              std::declval<value_type&>())))
    {
+      _sstl_record_container_stats(this);
       sstl_assert(pos >= begin() && pos <= end());
       sstl_assert(size() < capacity());
       value_type value(std::forward<Args>(args)...);
@@ -423,64 +442,19 @@ public:
       _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value
                      && std::is_nothrow_destructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       sstl_assert(pos >= begin() && pos < end());
-      auto current = const_cast<pointer>(pos);
-      #if _sstl_has_exceptions()
-      try
-      {
-      #endif
-         while(current+1 != end())
-         {
-            *current = std::move(*(current+1));
-            ++current;
-         }
-      #if _sstl_has_exceptions()
-      }
-      catch(...)
-      {
-         clear();
-         throw;
-      }
-      #endif
-      current->~value_type();
-      _sstl_member_of_derived_class(this, _end_) = current;
-      return const_cast<iterator>(pos);
+      auto nonconst_pos = const_cast<iterator>(pos);
+      return _erase(nonconst_pos, nonconst_pos+1, _is_trivially_relocatable{});
    }
 
    iterator erase(const_iterator range_begin, const_iterator range_end)
       _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value && std::is_nothrow_destructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       sstl_assert(range_begin <= range_end);
       sstl_assert(range_begin >= begin() && range_end <= end());
-      auto dst = const_cast<pointer>(range_begin);
-      auto src = const_cast<pointer>(range_end);
-
-      #if _sstl_has_exceptions()
-      try
-      {
-      #endif
-         while(src != end())
-         {
-            *dst = std::move(*src);
-            ++src; ++dst;
-         }
-      #if _sstl_has_exceptions()
-      }
-      catch(...)
-      {
-         clear();
-         throw;
-      }
-      #endif
-      auto new_end = dst;
-
-      while(dst != end())
-      {
-         dst->~value_type();
-         ++dst;
-      }
-      _sstl_member_of_derived_class(this, _end_) = new_end;
-      return const_cast<iterator>(range_begin);
+      return _erase(const_cast<iterator>(range_begin), const_cast<iterator>(range_end), _is_trivially_relocatable{});
    }
 
    void push_back(const_reference value)
@@ -501,6 +475,7 @@ public:
    void emplace_back(Args&&... args)
       _sstl_noexcept(std::is_nothrow_constructible<value_type, typename std::add_rvalue_reference<Args>::type...>::value)
    {
+      _sstl_record_container_stats(this);
       sstl_assert(size() < capacity());
       new(end()) value_type(std::forward<Args>(args)...);
       _sstl_member_of_derived_class(this, _end_) = end()+1;
@@ -509,78 +484,113 @@ public:
    void pop_back()
       _sstl_noexcept(std::is_nothrow_destructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       sstl_assert(!empty());
       (end()-1)->~value_type();
       _sstl_member_of_derived_class(this, _end_) = end()-1;
    }
 
-   void swap(vector& rhs)
-      _sstl_noexcept(std::is_nothrow_move_constructible<value_type>::value
-                     && std::is_nothrow_move_assignable<value_type>::value
+   //resizes the vector, default-initializing the new elements, i.e. elements of trivial types
+   //(e.g. bytes that are about to be overwritten) are left uninitialized instead of being zeroed
+   void resize_default_init(size_type count)
+      _sstl_noexcept(std::is_nothrow_default_constructible<value_type>::value
                      && std::is_nothrow_destructible<value_type>::value)
    {
-      sstl_assert(rhs.size() <= capacity());
-      sstl_assert(size() <= rhs.capacity());
-      vector *large, *small;
-
-      if(size() < rhs.size())
+      _sstl_record_container_stats(this);
+      sstl_assert(count <= capacity());
+      auto new_end = begin() + count;
+      auto pos = end();
+      if(new_end < pos)
       {
-         large = &rhs;
-         small = this;
+         while(pos != new_end)
+            (--pos)->~value_type();
       }
       else
       {
-         large = this;
-         small = &rhs;
-      }
-
-      auto large_pos = large->begin();
-      auto large_end_swaps = large->begin() + small->size();
-      auto large_end = large->end();
-      auto small_pos = small->begin();
-
-      #if _sstl_has_exceptions()
-      try
-      {
-      #endif
-         while(large_pos != large_end_swaps)
-         {
-            std::iter_swap(large_pos, small_pos);
-            ++large_pos; ++small_pos;
-         }
-         while(large_pos != large_end)
-         {
-            new(small_pos) value_type(std::move(*large_pos));
-            large_pos->~value_type();
-            ++large_pos; ++small_pos;
-         }
-      #if _sstl_has_exceptions()
-      }
-      catch(...)
-      {
-         if(large_pos >= large_end_swaps)
+         #if _sstl_has_exceptions()
+         try
          {
-            while(large_pos != large_end)
+         #endif
+            while(pos != new_end)
             {
-               large_pos->~value_type();
-               ++large_pos;
+               new(pos) value_type;
+               ++pos;
             }
-            _sstl_member_of_derived_class(large, _end_) = large_end_swaps;
-            _sstl_member_of_derived_class(small, _end_) = small_pos;
+         #if _sstl_has_exceptions()
          }
-         large->clear();
-         small->clear();
-         throw;
+         catch(...)
+         {
+            while(pos != end())
+               (--pos)->~value_type();
+            throw;
+         }
+         #endif
       }
-      #endif
-      
-      _sstl_member_of_derived_class(large, _end_) = large_end_swaps;
-      _sstl_member_of_derived_class(small, _end_) = small_pos;
+      _sstl_member_of_derived_class(this, _end_) = new_end;
+   }
+
+   //returns a pointer to the uninitialized storage that follows the last element, where the caller
+   //can construct (or, for trivial types, directly write, e.g. with recv/read) up to count new elements.
+   //The new elements become part of the vector once they are committed
+   pointer append_uninitialized(size_type count) _sstl_noexcept_
+   {
+      sstl_assert(size() + count <= capacity());
+      (void)count;
+      return end();
+   }
+
+   //appends the count elements constructed into the storage returned by append_uninitialized
+   void commit(size_type count) _sstl_noexcept_
+   {
+      _sstl_record_container_stats(this);
+      sstl_assert(size() + count <= capacity());
+      _sstl_member_of_derived_class(this, _end_) = end() + count;
+   }
+
+   void swap(vector& rhs)
+      _sstl_noexcept(std::is_nothrow_move_constructible<value_type>::value
+                     && std::is_nothrow_move_assignable<value_type>::value
+                     && std::is_nothrow_destructible<value_type>::value)
+   {
+      _sstl_record_container_stats(this);
+      _sstl_record_container_stats(&rhs);
+      sstl_assert(rhs.size() <= capacity());
+      sstl_assert(size() <= rhs.capacity());
+      _swap(rhs, _is_trivially_copyable{});
    }
 
+   #if _sstl_has_stats()
+   const container_stats& stats() const _sstl_noexcept_
+   {
+      return _sstl_member_of_derived_class(this, _stats);
+   }
+
+   void reset_stats() _sstl_noexcept_
+   {
+      _sstl_member_of_derived_class(this, _stats) = container_stats{};
+      _sstl_member_of_derived_class(this, _stats).high_water_mark = size();
+   }
+   #endif
+
 protected:
    using _type_for_hacky_derived_class_access = vector<value_type, 11>;
    static const bool _is_copy = true;
+   static const size_type _SWAP_CHUNK_SIZE = 256; //bytes
+
+   //trivially copyable elements can be copied/moved in bulk with memcpy/memmove
+   using _is_trivially_copyable = std::is_trivially_copyable<value_type>;
+
+   //trivially relocatable elements can be shifted in bulk with memmove (without move-constructing,
+   //move-assigning or destroying them), see sstl::is_trivially_relocatable
+   using _is_trivially_relocatable = sstl::is_trivially_relocatable<value_type>;
+
+   //a range can be copied in bulk if, in addition, it is a contiguous array of value_type
+   template<class TIterator>
+   struct _is_trivially_copyable_range : std::integral_constant<bool,
+         _is_trivially_copyable::value
+         && std::is_pointer<TIterator>::value
+         && std::is_same<typename std::remove_cv<typename std::remove_pointer<TIterator>::type>::type, value_type>::value>
+   {};
 
 protected:
    vector() _sstl_noexcept_ = default;
@@ -591,6 +601,7 @@ protected:
    void _count_constructor(size_type count, const_reference value)
       _sstl_noexcept(std::is_nothrow_copy_constructible<value_type>::value)
    {
+      _sstl_record_container_stats(this);
       #if _sstl_has_exceptions()
       try
       {
@@ -610,6 +621,23 @@ protected:
    template<class TIterator, class = typename std::enable_if<_is_input_iterator<TIterator>::value>::type>
    void _range_constructor(TIterator range_begin, TIterator range_end)
       _sstl_noexcept(std::is_nothrow_copy_constructible<value_type>::value)
+   {
+      _sstl_record_container_stats(this);
+      _range_constructor(range_begin, range_end, _is_trivially_copyable_range<TIterator>{});
+   }
+
+   template<class TIterator>
+   void _range_constructor(TIterator range_begin, TIterator range_end, std::true_type) _sstl_noexcept_
+   {
+      auto count = static_cast<size_type>(range_end - range_begin);
+      sstl_assert(count <= capacity());
+      _memcpy_elements(begin(), range_begin, count);
+      _sstl_member_of_derived_class(this, _end_) = begin() + count;
+   }
+
+   template<class TIterator>
+   void _range_constructor(TIterator range_begin, TIterator range_end, std::false_type)
+      _sstl_noexcept(std::is_nothrow_copy_constructible<value_type>::value)
    {
       auto src = range_begin;
       auto dst = begin();
@@ -640,6 +668,24 @@ protected:
       _sstl_noexcept(std::is_nothrow_copy_assignable<value_type>::value
                      && std::is_nothrow_copy_constructible<value_type>::value
                      && std::is_nothrow_destructible<value_type>::value)
+   {
+      _copy_assign(rhs_begin, rhs_end, _is_trivially_copyable_range<TIterator>{});
+   }
+
+   template<class TIterator>
+   void _copy_assign(TIterator rhs_begin, TIterator rhs_end, std::true_type) _sstl_noexcept_
+   {
+      auto count = static_cast<size_type>(rhs_end - rhs_begin);
+      sstl_assert(count <= capacity());
+      _memmove_elements(begin(), rhs_begin, count); //the range might belong to this vector
+      _sstl_member_of_derived_class(this, _end_) = begin() + count;
+   }
+
+   template<class TIterator>
+   void _copy_assign(TIterator rhs_begin, TIterator rhs_end, std::false_type)
+      _sstl_noexcept(std::is_nothrow_copy_assignable<value_type>::value
+                     && std::is_nothrow_copy_constructible<value_type>::value
+                     && std::is_nothrow_destructible<value_type>::value)
    {
       auto src = rhs_begin;
       auto dest = begin();
@@ -677,6 +723,23 @@ protected:
       _sstl_noexcept((std::is_nothrow_move_constructible<value_type>::value
                      || std::is_nothrow_copy_constructible<value_type>::value)
                      && std::is_nothrow_destructible<value_type>::value)
+   {
+      _sstl_record_container_stats(this);
+      _sstl_record_container_stats(&rhs);
+      _move_constructor(std::move(rhs), _is_trivially_copyable{});
+   }
+
+   void _move_constructor(vector&& rhs, std::true_type) _sstl_noexcept_
+   {
+      _memcpy_elements(begin(), rhs.begin(), rhs.size());
+      _sstl_member_of_derived_class(this, _end_) = begin() + rhs.size();
+      _sstl_member_of_derived_class(&rhs, _end_) = rhs.begin();
+   }
+
+   void _move_constructor(vector&& rhs, std::false_type)
+      _sstl_noexcept((std::is_nothrow_move_constructible<value_type>::value
+                     || std::is_nothrow_copy_constructible<value_type>::value)
+                     && std::is_nothrow_destructible<value_type>::value)
    {
       auto src = rhs.begin();
       auto dst = begin();
@@ -722,6 +785,24 @@ protected:
       _sstl_noexcept((std::is_nothrow_move_assignable<value_type>::value || std::is_nothrow_copy_assignable<value_type>::value)
                      && (std::is_nothrow_move_constructible<value_type>::value || std::is_nothrow_copy_constructible<value_type>::value)
                      && std::is_nothrow_destructible<value_type>::value)
+   {
+      _move_assign(rhs_begin, rhs_end, _is_trivially_copyable_range<TIterator>{});
+   }
+
+   template<class TIterator>
+   void _move_assign(TIterator rhs_begin, TIterator rhs_end, std::true_type) _sstl_noexcept_
+   {
+      auto count = static_cast<size_type>(rhs_end - rhs_begin);
+      sstl_assert(count <= capacity());
+      _memmove_elements(begin(), rhs_begin, count); //self move assignment
+      _sstl_member_of_derived_class(this, _end_) = begin() + count;
+   }
+
+   template<class TIterator>
+   void _move_assign(TIterator rhs_begin, TIterator rhs_end, std::false_type)
+      _sstl_noexcept((std::is_nothrow_move_assignable<value_type>::value || std::is_nothrow_copy_assignable<value_type>::value)
+                     && (std::is_nothrow_move_constructible<value_type>::value || std::is_nothrow_copy_constructible<value_type>::value)
+                     && std::is_nothrow_destructible<value_type>::value)
    {
       auto src = rhs_begin;
       auto dest = begin();
@@ -803,6 +884,44 @@ protected:
       _sstl_noexcept(std::is_nothrow_move_constructible<value_type>::value
                      && std::is_nothrow_move_assignable<value_type>::value
                      && (!is_copy_insertion || std::is_nothrow_copy_constructible<value_type>::value))
+   {
+      return _insert<is_copy_insertion>(pos, value, _is_trivially_relocatable{});
+   }
+
+   //relocates the tail by one position with a raw memory move, then constructs the new element
+   //in the gap. If the construction throws, the tail is relocated back (strong exception guarantee)
+   template<bool is_copy_insertion>
+   iterator _insert(iterator pos, reference value, std::true_type)
+      _sstl_noexcept(is_copy_insertion ? std::is_nothrow_copy_constructible<value_type>::value
+                                       : std::is_nothrow_move_constructible<value_type>::value)
+   {
+      auto value_pointer = std::addressof(value);
+      if(value_pointer >= pos && value_pointer < end()) //the value is an element that gets relocated
+         ++value_pointer;
+      auto tail_size = static_cast<size_type>(end() - pos);
+      _memmove_elements(pos + 1, pos, tail_size);
+      #if _sstl_has_exceptions()
+      try
+      {
+      #endif
+         new(pos) value_type(_conditional_move<!is_copy_insertion>(*value_pointer));
+      #if _sstl_has_exceptions()
+      }
+      catch(...)
+      {
+         _memmove_elements(pos, pos + 1, tail_size);
+         throw;
+      }
+      #endif
+      _sstl_member_of_derived_class(this, _end_) = end()+1;
+      return pos;
+   }
+
+   template<bool is_copy_insertion>
+   iterator _insert(iterator pos, reference value, std::false_type)
+      _sstl_noexcept(std::is_nothrow_move_constructible<value_type>::value
+                     && std::is_nothrow_move_assignable<value_type>::value
+                     && (!is_copy_insertion || std::is_nothrow_copy_constructible<value_type>::value))
    {
       if(pos != end())
       {
@@ -843,61 +962,131 @@ protected:
       return pos;
    }
 
-   template<class TIterator, class = typename std::enable_if<_is_bidirectional_iterator<TIterator>::value>::type>
+   template<class TIterator, class = typename std::enable_if<_is_forward_iterator<TIterator>::value>::type>
    iterator _insert(iterator pos, TIterator range_begin, TIterator range_end)
       _sstl_noexcept(std::is_nothrow_move_constructible<value_type>::value
                      && std::is_nothrow_move_assignable<value_type>::value
                      && noexcept(value_type(*std::declval<TIterator&>()))
                      && noexcept(std::declval<value_type&>() = *std::declval<TIterator&>()))
    {
-      auto count = std::distance(range_begin, range_end);
-      auto new_end = end() + count;
-      auto src_range = range_end - 1;
-      auto src_vector = end() - 1;
-      auto dst_vector = new_end - 1;
+      return _insert(pos, range_begin, range_end, _is_trivially_relocatable{});
+   }
 
+   //relocates the tail with a raw memory move to open the gap, then constructs the range in it.
+   //If a construction throws, the tail is relocated back (strong exception guarantee)
+   template<class TIterator>
+   iterator _insert(iterator pos, TIterator range_begin, TIterator range_end, std::true_type)
+      _sstl_noexcept(noexcept(value_type(*std::declval<TIterator&>())))
+   {
+      auto count = static_cast<size_type>(std::distance(range_begin, range_end));
+      auto tail_size = static_cast<size_type>(end() - pos);
+      _memmove_elements(pos + count, pos, tail_size);
       #if _sstl_has_exceptions()
       try
       {
       #endif
-         auto end_src_move_construction = std::max(pos-1, end()-count-1);
-         while(src_vector > end_src_move_construction)
+         _construct_range(pos, range_begin, range_end, _is_trivially_copyable_range<TIterator>{});
+      #if _sstl_has_exceptions()
+      }
+      catch(...)
+      {
+         _memmove_elements(pos, pos + count, tail_size);
+         throw;
+      }
+      #endif
+      _sstl_member_of_derived_class(this, _end_) = end() + count;
+      return pos;
+   }
+
+   template<class TIterator>
+   static void _construct_range(pointer dst, TIterator range_begin, TIterator range_end, std::true_type) _sstl_noexcept_
+   {
+      _memcpy_elements(dst, range_begin, static_cast<size_type>(range_end - range_begin));
+   }
+
+   //constructs the range into raw memory. If a construction throws, destroys the constructed elements
+   template<class TIterator>
+   static void _construct_range(pointer dst, TIterator range_begin, TIterator range_end, std::false_type)
+      _sstl_noexcept(noexcept(value_type(*std::declval<TIterator&>())))
+   {
+      auto crt = dst;
+      #if _sstl_has_exceptions()
+      try
+      {
+      #endif
+         while(range_begin != range_end)
          {
-            new(dst_vector) value_type(std::move(*src_vector));
-            --src_vector; --dst_vector;
+            new(crt) value_type(*range_begin);
+            ++range_begin; ++crt;
          }
+      #if _sstl_has_exceptions()
+      }
+      catch(...)
+      {
+         while(crt != dst)
+            (--crt)->~value_type();
+         throw;
+      }
+      #endif
+   }
 
-         auto end_src_move_assignment = pos - 1;
-         while(src_vector > end_src_move_assignment)
+   //shifts the tail by the size of the range, then fills the gap traversing the range once (forward
+   //iterators suffice): first assigning over the moved-from elements, then constructing beyond the old end
+   template<class TIterator>
+   iterator _insert(iterator pos, TIterator range_begin, TIterator range_end, std::false_type)
+      _sstl_noexcept(std::is_nothrow_move_constructible<value_type>::value
+                     && std::is_nothrow_move_assignable<value_type>::value
+                     && noexcept(value_type(*std::declval<TIterator&>()))
+                     && noexcept(std::declval<value_type&>() = *std::declval<TIterator&>()))
+   {
+      auto count = std::distance(range_begin, range_end);
+      auto old_end = end();
+      auto new_end = old_end + count;
+      auto gap_end = pos + count;
+      auto constructed_begin = new_end; //begin of the elements move-constructed beyond the old end by the shift
+      #if _sstl_has_exceptions()
+      auto initialized_end = old_end; //end of the elements constructed beyond the old end by the filling
+      #endif
+
+      #if _sstl_has_exceptions()
+      try
+      {
+      #endif
+         auto src = old_end;
+         auto end_src_move_construction = std::max(pos, old_end - count);
+         while(src != end_src_move_construction)
          {
-            *dst_vector = std::move(*src_vector);
-            --src_vector; --dst_vector;
+            --src;
+            new(constructed_begin - 1) value_type(std::move(*src));
+            --constructed_begin;
          }
+         std::move_backward(pos, src, constructed_begin);
 
-         auto end_dst_construction = end() - 1;
-         while(dst_vector > end_dst_construction)
+         auto dst = pos;
+         auto end_dst_assignment = std::min(gap_end, old_end);
+         while(dst != end_dst_assignment)
          {
-            new(dst_vector) value_type(*src_range);
-            --dst_vector; --src_range;
+            *dst = *range_begin;
+            ++dst; ++range_begin;
          }
-
-         auto end_dst_assignment = pos - 1;
-         while(dst_vector > end_dst_assignment)
+         while(dst != gap_end)
          {
-            *dst_vector = *src_range;
-            --dst_vector; --src_range;
+            new(dst) value_type(*range_begin);
+            ++dst; ++range_begin;
+            #if _sstl_has_exceptions()
+            initialized_end = dst;
+            #endif
          }
       #if _sstl_has_exceptions()
       }
       catch(...)
       {
-         for(auto p=new_end-1; p>dst_vector; --p)
+         for(auto p=constructed_begin; p!=new_end; ++p)
             p->~value_type();
-         if(pos != end())
-         {
-            _sstl_member_of_derived_class(this, _end_) = std::min(end(), dst_vector+1);
+         for(auto p=old_end; p!=initialized_end; ++p)
+            p->~value_type();
+         if(pos != old_end)
             clear();
-         }
          throw;
       }
       #endif
@@ -905,6 +1094,159 @@ protected:
 
       return pos;
    }
+
+   //swaps the common prefix of the two buffers chunk by chunk (through a small
+   //scratch buffer), then copies the remaining elements of the larger vector
+   void _swap(vector& rhs, std::true_type) _sstl_noexcept_
+   {
+      if(this == &rhs)
+         return;
+      auto lhs_size = size();
+      auto rhs_size = rhs.size();
+      auto lhs_bytes = static_cast<unsigned char*>(static_cast<void*>(begin()));
+      auto rhs_bytes = static_cast<unsigned char*>(static_cast<void*>(rhs.begin()));
+      auto common_bytes = std::min(lhs_size, rhs_size) * sizeof(value_type);
+
+      unsigned char scratch[_SWAP_CHUNK_SIZE];
+      size_type offset = 0;
+      //the full chunks are copied with a constant size, which lets the compiler inline the copies
+      for(; offset + _SWAP_CHUNK_SIZE <= common_bytes; offset += _SWAP_CHUNK_SIZE)
+      {
+         std::memcpy(scratch, lhs_bytes + offset, _SWAP_CHUNK_SIZE);
+         std::memcpy(lhs_bytes + offset, rhs_bytes + offset, _SWAP_CHUNK_SIZE);
+         std::memcpy(rhs_bytes + offset, scratch, _SWAP_CHUNK_SIZE);
+      }
+      auto remaining_bytes = common_bytes - offset;
+      std::memcpy(scratch, lhs_bytes + offset, remaining_bytes);
+      std::memcpy(lhs_bytes + offset, rhs_bytes + offset, remaining_bytes);
+      std::memcpy(rhs_bytes + offset, scratch, remaining_bytes);
+
+      if(lhs_size < rhs_size)
+         _memcpy_elements(begin() + lhs_size, rhs.begin() + lhs_size, rhs_size - lhs_size);
+      else
+         _memcpy_elements(rhs.begin() + rhs_size, begin() + rhs_size, lhs_size - rhs_size);
+
+      _sstl_member_of_derived_class(this, _end_) = begin() + rhs_size;
+      _sstl_member_of_derived_class(&rhs, _end_) = rhs.begin() + lhs_size;
+   }
+
+   void _swap(vector& rhs, std::false_type)
+      _sstl_noexcept(std::is_nothrow_move_constructible<value_type>::value
+                     && std::is_nothrow_move_assignable<value_type>::value
+                     && std::is_nothrow_destructible<value_type>::value)
+   {
+      vector *large, *small;
+
+      if(size() < rhs.size())
+      {
+         large = &rhs;
+         small = this;
+      }
+      else
+      {
+         large = this;
+         small = &rhs;
+      }
+
+      auto large_pos = large->begin();
+      auto large_end_swaps = large->begin() + small->size();
+      auto large_end = large->end();
+      auto small_pos = small->begin();
+
+      #if _sstl_has_exceptions()
+      try
+      {
+      #endif
+         while(large_pos != large_end_swaps)
+         {
+            std::iter_swap(large_pos, small_pos);
+            ++large_pos; ++small_pos;
+         }
+         while(large_pos != large_end)
+         {
+            new(small_pos) value_type(std::move(*large_pos));
+            large_pos->~value_type();
+            ++large_pos; ++small_pos;
+         }
+      #if _sstl_has_exceptions()
+      }
+      catch(...)
+      {
+         if(large_pos >= large_end_swaps)
+         {
+            while(large_pos != large_end)
+            {
+               large_pos->~value_type();
+               ++large_pos;
+            }
+            _sstl_member_of_derived_class(large, _end_) = large_end_swaps;
+            _sstl_member_of_derived_class(small, _end_) = small_pos;
+         }
+         large->clear();
+         small->clear();
+         throw;
+      }
+      #endif
+      
+      _sstl_member_of_derived_class(large, _end_) = large_end_swaps;
+      _sstl_member_of_derived_class(small, _end_) = small_pos;
+   }
+
+   iterator _erase(iterator range_begin, iterator range_end, std::true_type)
+      _sstl_noexcept(std::is_nothrow_destructible<value_type>::value)
+   {
+      for(auto p=range_begin; p!=range_end; ++p)
+         p->~value_type();
+      _memmove_elements(range_begin, range_end, static_cast<size_type>(end() - range_end));
+      _sstl_member_of_derived_class(this, _end_) = end() - (range_end - range_begin);
+      return range_begin;
+   }
+
+   iterator _erase(iterator range_begin, iterator range_end, std::false_type)
+      _sstl_noexcept(std::is_nothrow_move_assignable<value_type>::value && std::is_nothrow_destructible<value_type>::value)
+   {
+      auto dst = range_begin;
+      auto src = range_end;
+
+      #if _sstl_has_exceptions()
+      try
+      {
+      #endif
+         while(src != end())
+         {
+            *dst = std::move(*src);
+            ++src; ++dst;
+         }
+      #if _sstl_has_exceptions()
+      }
+      catch(...)
+      {
+         clear();
+         throw;
+      }
+      #endif
+      auto new_end = dst;
+
+      while(dst != end())
+      {
+         dst->~value_type();
+         ++dst;
+      }
+      _sstl_member_of_derived_class(this, _end_) = new_end;
+      return range_begin;
+   }
+
+   static void _memcpy_elements(pointer dst, const_pointer src, size_type count) _sstl_noexcept_
+   {
+      if(count > 0)
+         std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(value_type));
+   }
+
+   static void _memmove_elements(pointer dst, const_pointer src, size_type count) _sstl_noexcept_
+   {
+      if(count > 0)
+         std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(value_type));
+   }
 };
 
 template<class T, size_t Capacity>
@@ -1029,9 +1371,110 @@ public:
       return *this;
    }
 
+   //the hot non-modifying operations hide the ones of the capacity-agnostic base: when the sized type
+   //is known, the member variables are accessed directly and the capacity is a compile-time constant
+   reference operator[](size_type idx) _sstl_noexcept_
+   {
+      sstl_assert(idx < size());
+      return begin()[idx];
+   }
+
+   const_reference operator[](size_type idx) const _sstl_noexcept_
+   {
+      sstl_assert(idx < size());
+      return begin()[idx];
+   }
+
+   reference front() _sstl_noexcept_
+   {
+      sstl_assert(!empty());
+      return *begin();
+   }
+
+   const_reference front() const _sstl_noexcept_
+   {
+      sstl_assert(!empty());
+      return *begin();
+   }
+
+   reference back() _sstl_noexcept_
+   {
+      sstl_assert(!empty());
+      return *(_end_-1);
+   }
+
+   const_reference back() const _sstl_noexcept_
+   {
+      sstl_assert(!empty());
+      return *(_end_-1);
+   }
+
+   pointer data() _sstl_noexcept_
+   {
+      return begin();
+   }
+
+   const_pointer data() const _sstl_noexcept_
+   {
+      return begin();
+   }
+
+   iterator begin() _sstl_noexcept_
+   {
+      return static_cast<iterator>(static_cast<void*>(_buffer_));
+   }
+
+   const_iterator begin() const _sstl_noexcept_
+   {
+      return static_cast<const_iterator>(static_cast<const void*>(_buffer_));
+   }
+
+   const_iterator cbegin() const _sstl_noexcept_
+   {
+      return begin();
+   }
+
+   iterator end() _sstl_noexcept_
+   {
+      return _end_;
+   }
+
+   const_iterator end() const _sstl_noexcept_
+   {
+      return _end_;
+   }
+
+   const_iterator cend() const _sstl_noexcept_
+   {
+      return _end_;
+   }
+
+   bool empty() const _sstl_noexcept_
+   {
+      return _end_ == begin();
+   }
+
+   size_type size() const _sstl_noexcept_
+   {
+      return static_cast<size_type>(_end_ - begin());
+   }
+
+   size_type max_size() const _sstl_noexcept_
+   {
+      return Capacity;
+   }
+
+   size_type capacity() const _sstl_noexcept_
+   {
+      return Capacity;
+   }
+
 private:
    size_type _capacity_{ Capacity };
-   pointer _end_;
+   pointer _end_{ _base::begin() };
+   #if _sstl_has_stats()
+   container_stats _stats;
+   #endif
    typename _aligned_storage<sizeof(value_type), std::alignment_of<value_type>::value>::type _buffer_[Capacity];
 };
 
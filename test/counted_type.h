@@ -12,6 +12,7 @@ as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
 #include <cassert>
 #include <stdexcept>
 #include <sstl/__internal/_except.h>
+#include <sstl/type_traits.h>
 
 namespace sstl_test
 {
@@ -357,6 +358,20 @@ private:
    static const size_t invalid_count = static_cast<size_t>(-1);
 };
 
+//counted type that opts in to sstl::is_trivially_relocatable (see specialization below)
+class relocatable_counted_type : public counted_type
+{
+public:
+   using counted_type::counted_type;
+};
+
+}
+
+namespace sstl
+{
+template<>
+struct is_trivially_relocatable<sstl_test::relocatable_counted_type> : std::true_type
+{};
 }
 
 #endif
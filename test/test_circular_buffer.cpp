@@ -0,0 +1,88 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <catch.hpp>
+#include <vector>
+#include <string>
+#include <type_traits>
+#include <sstl/circular_buffer.h>
+
+#include "utility.h"
+#include "counted_type.h"
+
+namespace sstl_test
+{
+
+TEST_CASE("circular_buffer - keeps the newest elements")
+{
+   auto buffer = sstl::circular_buffer<int, 4>{};
+   for(int i=0; i<3; ++i)
+      buffer.push_back(i);
+   REQUIRE(are_containers_equal(buffer, std::initializer_list<int>{0, 1, 2}));
+
+   for(int i=3; i<10; ++i)
+      buffer.emplace_back(i);
+   REQUIRE(buffer.full());
+   REQUIRE(are_containers_equal(buffer, std::initializer_list<int>{6, 7, 8, 9}));
+
+   auto snapshot = std::vector<int>(4);
+   REQUIRE(buffer.snapshot(snapshot.begin()) == snapshot.end());
+   REQUIRE(snapshot == (std::vector<int>{6, 7, 8, 9}));
+}
+
+TEST_CASE("circular_buffer - the deque base class isn't accessible")
+{
+   //a deque reference would allow to insert into a full buffer (e.g. push_front)
+   REQUIRE(!std::is_convertible<sstl::circular_buffer<int, 4>&, sstl::deque<int>&>::value);
+   REQUIRE(!std::is_convertible<sstl::circular_buffer<int, 4>&, sstl::deque<int, 4>&>::value);
+}
+
+TEST_CASE("circular_buffer - the new element is a copy of the overwritten one")
+{
+   //strings longer than the small string buffer, so that a copy from a destroyed string would be detected
+   auto values = std::vector<std::string>{ std::string(64, 'a'), std::string(64, 'b'), std::string(64, 'c') };
+   SECTION("push_back")
+   {
+      auto buffer = sstl::circular_buffer<std::string, 3>{};
+      for(const auto& value : values)
+         buffer.push_back(value);
+      buffer.push_back(buffer.front());
+      REQUIRE(are_containers_equal(buffer, std::initializer_list<std::string>{ values[1], values[2], values[0] }));
+   }
+   SECTION("emplace_back")
+   {
+      auto buffer = sstl::circular_buffer<std::string, 3>{};
+      for(const auto& value : values)
+         buffer.emplace_back(value);
+      buffer.emplace_back(buffer.front(), 1);
+      REQUIRE(are_containers_equal(buffer, std::initializer_list<std::string>{ values[1], values[2], values[0].substr(1) }));
+   }
+   SECTION("counted type")
+   {
+      auto buffer = sstl::circular_buffer<counted_type, 3>{};
+      for(size_t i=0; i<3; ++i)
+         buffer.emplace_back(i);
+      counted_type::reset_counts();
+      buffer.push_back(buffer.front());
+      REQUIRE(counted_type::check().copy_constructions(1).move_constructions(1).destructions(2));
+      REQUIRE(are_containers_equal(buffer, std::initializer_list<counted_type>{1, 2, 0}));
+   }
+}
+
+TEST_CASE("circular_buffer - non-trivial value type")
+{
+   {
+      auto buffer = sstl::circular_buffer<counted_type, 3>{};
+      for(size_t i=0; i<5; ++i)
+         buffer.emplace_back(i);
+      REQUIRE(are_containers_equal(buffer, std::initializer_list<counted_type>{2, 3, 4}));
+      counted_type::reset_counts();
+   }
+   REQUIRE(counted_type::check().destructions(3));
+}
+
+}
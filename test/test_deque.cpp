@@ -7,6 +7,8 @@ as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
 
 #include <catch.hpp>
 #include <algorithm>
+#include <vector>
+#include <deque>
 #include <sstl/__internal/_except.h>
 #include <sstl/deque.h>
 
@@ -753,6 +755,191 @@ TEST_CASE("deque - max_size")
    }
 }
 
+TEST_CASE("deque - sized and capacity-agnostic accessors are equivalent")
+{
+   auto d = make_noncontiguous_deque<int>({1, 3, 7, 11, 13});
+   const auto& sized = d;
+   const sstl::deque<int>& base = d;
+   for(size_t i=0; i<d.size(); ++i)
+   {
+      REQUIRE(&sized[i] == &base[i]);
+   }
+   REQUIRE(&sized.front() == &base.front());
+   REQUIRE(&sized.back() == &base.back());
+   REQUIRE(sized.size() == base.size());
+   REQUIRE(sized.empty() == base.empty());
+   REQUIRE(sized.full() == base.full());
+   REQUIRE(sized.capacity() == base.capacity());
+   REQUIRE(sized.max_size() == base.max_size());
+}
+
+TEST_CASE("deque - segments")
+{
+   SECTION("empty")
+   {
+      auto d = sstl::deque<int, 11>{};
+      auto segments = d.as_spans();
+      REQUIRE(segments[0].size + segments[1].size == 0);
+      auto free_segments = d.free_spans();
+      REQUIRE(free_segments[0].size + free_segments[1].size == 11);
+   }
+   SECTION("contiguous")
+   {
+      auto d = sstl::deque<int, 11>{1, 3, 7};
+      auto segments = d.as_spans();
+      REQUIRE(segments[0].data == &d.front());
+      REQUIRE(segments[0].size == 3);
+      REQUIRE(segments[1].size == 0);
+      auto free_segments = d.free_spans();
+      REQUIRE(free_segments[0].data == &d.back()+1);
+      REQUIRE(free_segments[0].size == 8);
+      REQUIRE(free_segments[1].size == 0);
+   }
+   SECTION("wrapped")
+   {
+      auto d = make_noncontiguous_deque<int>({1, 3, 7, 11, 13});
+      const auto& cd = d;
+      auto segments = cd.as_spans();
+      REQUIRE(segments[0].data == &d.front());
+      REQUIRE(segments[0].size + segments[1].size == 5);
+      REQUIRE(segments[1].size > 0);
+      REQUIRE(segments[1].data + segments[1].size - 1 == &d.back());
+      auto values = std::vector<int>{};
+      cd.for_each_segment([&values](const int* data, size_t size)
+      {
+         values.insert(values.end(), data, data+size);
+      });
+      REQUIRE(values == (std::vector<int>{1, 3, 7, 11, 13}));
+
+      auto free_segments = d.free_spans();
+      REQUIRE(free_segments[0].data == &d.back()+1);
+      REQUIRE(free_segments[0].size + free_segments[1].size == 6);
+      REQUIRE(free_segments[1].size == 0);
+   }
+   SECTION("full")
+   {
+      auto d = sstl::deque<int, 3>{1, 3, 7};
+      auto free_segments = d.free_spans();
+      REQUIRE(free_segments[0].size + free_segments[1].size == 0);
+   }
+   SECTION("production into the free segments")
+   {
+      auto d = sstl::deque<int, 11>{0, 1, 2, 3, 4, 5, 6};
+      for(size_t i=0; i<5; ++i)
+         d.pop_front();
+      auto free_segments = d.free_spans();
+      REQUIRE(free_segments[0].size == 4);
+      REQUIRE(free_segments[1].size == 5);
+      int value = 7;
+      d.for_each_free_segment([&value](int* data, size_t size)
+      {
+         for(size_t i=0; i<size; ++i)
+            data[i] = value++;
+      });
+      d.commit(9);
+      auto expected = std::vector<int>{5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+      REQUIRE(std::equal(expected.cbegin(), expected.cend(), d.cbegin()));
+      REQUIRE(d.full());
+   }
+}
+
+TEST_CASE("deque - bulk operations")
+{
+   SECTION("trivially copyable values (wrapping around the end of the storage)")
+   {
+      auto d = sstl::deque<int, 11>{0, 1, 2, 3, 4, 5, 6, 7};
+      d.pop_front_n(static_cast<int*>(nullptr), 0);
+      auto popped = std::vector<int>(6);
+      REQUIRE(d.pop_front_n(popped.data(), 6) == popped.data()+6);
+      REQUIRE(popped == (std::vector<int>{0, 1, 2, 3, 4, 5}));
+      auto pushed = std::vector<int>{8, 9, 10, 11, 12, 13, 14};
+      d.push_back_n(pushed.data(), pushed.size());
+      REQUIRE(d.size() == 9);
+      REQUIRE(d.as_spans()[1].size > 0);
+      d.pop_back_n(2);
+      d.emplace_back_n(2, 20);
+      auto expected = std::vector<int>{6, 7, 8, 9, 10, 11, 12, 20, 20};
+      REQUIRE(std::equal(expected.cbegin(), expected.cend(), d.cbegin()));
+      popped.resize(9);
+      d.pop_front_n(popped.data(), 9);
+      REQUIRE(popped == expected);
+      REQUIRE(d.empty());
+   }
+   SECTION("other iterators")
+   {
+      auto d = make_noncontiguous_deque<int>({1, 3});
+      auto values = std::deque<int>{5, 7, 11, 13};
+      d.push_back_n(values.cbegin(), values.size());
+      auto popped = std::vector<int>{};
+      d.pop_front_n(std::back_inserter(popped), 5);
+      REQUIRE(popped == (std::vector<int>{1, 3, 5, 7, 11}));
+      REQUIRE(d.size() == 1);
+      REQUIRE(d.front() == 13);
+   }
+   SECTION("non-trivial values")
+   {
+      auto d = make_noncontiguous_deque<counted_type>({0, 1, 2});
+      auto values = std::vector<counted_type>{3, 4, 5};
+      counted_type::reset_counts();
+      d.push_back_n(values.cbegin(), values.size());
+      REQUIRE(counted_type::check().copy_constructions(3));
+      counted_type::reset_counts();
+      d.emplace_back_n(2, 6);
+      REQUIRE(counted_type::check().parameter_constructions(2));
+      auto popped = std::vector<counted_type>(4);
+      counted_type::reset_counts();
+      d.pop_front_n(popped.begin(), 4);
+      REQUIRE(counted_type::check().move_assignments(4).destructions(4));
+      d.pop_back_n(3);
+      REQUIRE(counted_type::check().destructions(7));
+      REQUIRE(are_containers_equal(popped, std::initializer_list<counted_type>{0, 1, 2, 3}));
+      REQUIRE(are_containers_equal(d, std::initializer_list<counted_type>{4}));
+   }
+   #if _sstl_has_exceptions()
+   SECTION("exception handling")
+   {
+      auto d = make_noncontiguous_deque<counted_type>({0, 1, 2});
+      auto values = std::vector<counted_type>{3, 4, 5, 6};
+      counted_type::reset_counts();
+      counted_type::throw_at_nth_copy_construction(3);
+      REQUIRE_THROWS_AS(d.push_back_n(values.cbegin(), values.size()), counted_type::copy_construction::exception);
+      REQUIRE(counted_type::check().copy_constructions(2).destructions(2));
+      REQUIRE(are_containers_equal(d, std::initializer_list<counted_type>{0, 1, 2}));
+   }
+   #endif
+}
+
+TEST_CASE("deque - overwrite when full")
+{
+   SECTION("trivially destructible values")
+   {
+      auto d = sstl::deque<int, 5>{0, 1, 2};
+      for(int i=3; i<12; ++i)
+         d.push_back_overwrite(i);
+      REQUIRE(d.full());
+      REQUIRE(are_containers_equal(d, std::initializer_list<int>{7, 8, 9, 10, 11}));
+      auto snapshot = std::vector<int>(5);
+      d.snapshot(snapshot.data());
+      REQUIRE(snapshot == (std::vector<int>{7, 8, 9, 10, 11}));
+   }
+   SECTION("non-trivially destructible values")
+   {
+      auto d = deque_counted_type_t{};
+      for(size_t i=0; i<11; ++i)
+         d.emplace_back(i);
+      counted_type::reset_counts();
+      //the new element is constructed before the first one is destroyed, then moved in
+      d.emplace_back_overwrite(11);
+      REQUIRE(counted_type::check().parameter_constructions(1).move_constructions(1).destructions(2));
+      counted_type::reset_counts();
+      d.push_back_overwrite(counted_type{ 12 });
+      REQUIRE(counted_type::check().parameter_constructions(1).move_constructions(2).destructions(3));
+      REQUIRE(d.front() == 2);
+      REQUIRE(d.back() == 12);
+      REQUIRE(d.size() == 11);
+   }
+}
+
 TEST_CASE("deque - clear")
 {
    SECTION("contiguous values")
@@ -1715,6 +1902,156 @@ TEST_CASE("deque - insert (count + range versions)")
    #endif
 }
 
+//fills the deque with the values 0-6, starting from the specified position of its internal storage
+void fill_relocatable_deque(sstl::deque<relocatable_counted_type>& d, size_t storage_index)
+{
+   for(size_t i=0; i<storage_index; ++i)
+   {
+      d.push_back(0);
+      d.pop_front();
+   }
+   for(size_t i=0; i<7; ++i)
+   {
+      d.push_back(i);
+   }
+}
+
+bool are_relocatable_deque_values_equal(const sstl::deque<relocatable_counted_type>& d, std::vector<size_t> values)
+{
+   return std::equal(values.cbegin(), values.cend(), d.cbegin(), [](size_t lhs, const relocatable_counted_type& rhs)
+   {
+      return lhs == rhs.member;
+   }) && d.size() == values.size();
+}
+
+TEST_CASE("deque - insert (trivially relocatable value type)")
+{
+   auto values = std::initializer_list<relocatable_counted_type>{10, 11, 12};
+   //the storage indices and positions cover the relocations of the elements in both directions,
+   //with the source and/or the destination ranges wrapping around the end of the storage
+   //(no sections: the sections of a loop would be entered only at the first iteration)
+   for(size_t storage_index : {0, 4, 9})
+   {
+      for(size_t pos : {0, 2, 3, 4, 5, 7})
+      {
+         auto d = sstl::deque<relocatable_counted_type, 11>{};
+         auto expected = std::vector<size_t>{};
+         auto reset = [&]()
+         {
+            d.clear();
+            fill_relocatable_deque(d, storage_index);
+            expected = std::vector<size_t>{0, 1, 2, 3, 4, 5, 6};
+            counted_type::reset_counts();
+         };
+
+         //count
+         {
+            reset();
+            auto it = d.insert(d.cbegin()+pos, 3, values.begin()[0]);
+            REQUIRE(counted_type::check{}.copy_constructions(3).move_assignments(0).destructions(0));
+            REQUIRE(it == d.begin()+pos);
+            expected.insert(expected.begin()+pos, 3, 10);
+            REQUIRE(are_relocatable_deque_values_equal(d, expected));
+         }
+         //range
+         {
+            reset();
+            auto it = d.insert(d.cbegin()+pos, values.begin(), values.end());
+            REQUIRE(counted_type::check{}.copy_constructions(3).move_assignments(0).destructions(0));
+            REQUIRE(it == d.begin()+pos);
+            expected.insert(expected.begin()+pos, {10, 11, 12});
+            REQUIRE(are_relocatable_deque_values_equal(d, expected));
+         }
+         //single value
+         {
+            reset();
+            auto it = d.insert(d.cbegin()+pos, values.begin()[0]);
+            REQUIRE(counted_type::check{}.copy_constructions(1).move_assignments(0).destructions(0));
+            REQUIRE(it == d.begin()+pos);
+            expected.insert(expected.begin()+pos, 10);
+            REQUIRE(are_relocatable_deque_values_equal(d, expected));
+         }
+         //value belonging to the deque itself
+         {
+            reset();
+            d.insert(d.cbegin()+pos, 2, d[6]);
+            d.insert(d.cbegin()+pos, d[0]);
+            expected.insert(expected.begin()+pos, 2, 6);
+            expected.insert(expected.begin()+pos, expected[0]);
+            REQUIRE(are_relocatable_deque_values_equal(d, expected));
+         }
+         #if _sstl_has_exceptions()
+         //exception safety
+         {
+            reset();
+            counted_type::throw_at_nth_copy_construction(3);
+            REQUIRE_THROWS_AS(d.insert(d.cbegin()+pos, values.begin(), values.end()), counted_type::copy_construction::exception);
+            REQUIRE(counted_type::check{}.copy_constructions(2).destructions(2));
+            REQUIRE(are_relocatable_deque_values_equal(d, expected));
+            d.push_back(7);
+            d.push_front(8);
+            expected.push_back(7);
+            expected.insert(expected.begin(), 8);
+            REQUIRE(are_relocatable_deque_values_equal(d, expected));
+         }
+         #endif
+      }
+   }
+}
+
+TEST_CASE("deque - erase (trivially relocatable value type)")
+{
+   //the storage indices and positions cover the relocations of the elements in both directions,
+   //with the source and/or the destination ranges wrapping around the end of the storage
+   //(no sections: the sections of a loop would be entered only at the first iteration)
+   for(size_t storage_index : {0, 4, 9})
+   {
+      for(size_t pos : {0, 1, 2, 3, 4, 5, 6})
+      {
+         //position
+         {
+            auto expected = std::vector<size_t>{0, 1, 2, 3, 4, 5, 6};
+            auto d = sstl::deque<relocatable_counted_type, 11>{};
+            fill_relocatable_deque(d, storage_index);
+            counted_type::reset_counts();
+            auto it = d.erase(d.cbegin()+pos);
+            REQUIRE(counted_type::check{}.constructions(0).move_assignments(0).destructions(1));
+            REQUIRE(it == d.begin()+pos);
+            expected.erase(expected.begin()+pos);
+            REQUIRE(are_relocatable_deque_values_equal(d, expected));
+         }
+         //range
+         {
+            auto expected = std::vector<size_t>{0, 1, 2, 3, 4, 5, 6};
+            auto d = sstl::deque<relocatable_counted_type, 11>{};
+            fill_relocatable_deque(d, storage_index);
+            counted_type::reset_counts();
+            auto range_size = std::min<size_t>(3, 7-pos);
+            auto it = d.erase(d.cbegin()+pos, d.cbegin()+pos+range_size);
+            REQUIRE(counted_type::check{}.constructions(0).move_assignments(0).destructions(range_size));
+            REQUIRE(it == d.begin()+pos);
+            expected.erase(expected.begin()+pos, expected.begin()+pos+range_size);
+            REQUIRE(are_relocatable_deque_values_equal(d, expected));
+            d.push_back(7);
+            d.push_front(8);
+            expected.push_back(7);
+            expected.insert(expected.begin(), 8);
+            REQUIRE(are_relocatable_deque_values_equal(d, expected));
+         }
+      }
+   }
+   //all the elements
+   {
+      auto d = sstl::deque<relocatable_counted_type, 11>{};
+      fill_relocatable_deque(d, 9);
+      auto it = d.erase(d.cbegin(), d.cend());
+      REQUIRE(it == d.end());
+      REQUIRE(d.empty());
+      d.push_back(1);
+      REQUIRE(are_relocatable_deque_values_equal(d, {1}));
+   }
+}
+
 TEST_CASE("deque - erase (position)")
 {
    auto d = make_noncontiguous_deque<counted_type>({0, 1, 2, 3, 4, 5, 6});
@@ -2205,6 +2542,45 @@ TEST_CASE("deque - pop_front")
    REQUIRE(d == (deque_counted_type_t{}));
 }
 
+template<size_t CAPACITY>
+void check_wraparound_at_both_ends()
+{
+   auto d = sstl::deque<int, CAPACITY>{};
+   auto& base = static_cast<sstl::deque<int>&>(d);
+   auto expected = std::deque<int>{};
+   for(int i=0; i<int(CAPACITY)*5; ++i)
+   {
+      switch(i % 7)
+      {
+         case 0: case 2: case 4:
+            if(!d.full()) { d.push_back(i); expected.push_back(i); }
+            break;
+         case 1:
+            if(!d.full()) { d.push_front(i); expected.push_front(i); }
+            break;
+         case 3: case 5:
+            if(!d.empty()) { d.pop_front(); expected.pop_front(); }
+            break;
+         default:
+            if(!d.empty()) { d.pop_back(); expected.pop_back(); }
+            break;
+      }
+      REQUIRE(d.size() == expected.size());
+      for(size_t idx=0; idx<d.size(); ++idx)
+      {
+         REQUIRE(d[idx] == expected[idx]);
+      }
+      REQUIRE(std::equal(base.cbegin(), base.cend(), expected.cbegin()));
+   }
+}
+
+TEST_CASE("deque - wraparound (power-of-two and other capacities)")
+{
+   check_wraparound_at_both_ends<1>();
+   check_wraparound_at_both_ends<8>();
+   check_wraparound_at_both_ends<11>();
+}
+
 TEST_CASE("deque - swap")
 {
    SECTION("rhs' capacity is same")
@@ -2330,4 +2706,13 @@ TEST_CASE("deque - non-member relative operators")
    }
 }
 
+#if !_sstl_has_stats() //the statistics add member variables
+TEST_CASE("deque - memory footprint")
+{
+   using word_size_t = void*;
+   REQUIRE(sizeof(sstl::deque<word_size_t, 1>) == (4+1)*sizeof(word_size_t));
+   REQUIRE(sizeof(sstl::deque<word_size_t, 10>) == (4+10)*sizeof(word_size_t));
+}
+#endif
+
 }
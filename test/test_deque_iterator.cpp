@@ -7,6 +7,8 @@ as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
 
 #include <catch.hpp>
 #include <initializer_list>
+#include <algorithm>
+#include <numeric>
 
 #include <sstl/deque.h>
 #include "utility.h"
@@ -449,4 +451,40 @@ TEST_CASE_METHOD(fixture_deque_iterator, "deque_iterator - expressions required
    }
 }
 
+template<size_t CAPACITY>
+void check_linear_iterator()
+{
+   auto d = sstl::deque<int, CAPACITY>{};
+   for(size_t i=0; i<CAPACITY-3; ++i)
+   {
+      d.push_back(0);
+      d.pop_front();
+   }
+   for(int i=0; i<static_cast<int>(CAPACITY)-1; ++i)
+      d.push_back(i);
+   const auto& cd = d;
+
+   REQUIRE(d.linear_end() - d.linear_begin() == static_cast<ptrdiff_t>(d.size()));
+   REQUIRE(std::equal(cd.linear_cbegin(), cd.linear_cend(), d.cbegin()));
+   REQUIRE(std::accumulate(d.linear_begin(), d.linear_end(), 0) == std::accumulate(d.begin(), d.end(), 0));
+   REQUIRE(*std::find(d.linear_begin(), d.linear_end(), 3) == 3);
+   REQUIRE(&d.linear_begin()[2] == &d[2]);
+   REQUIRE(&*(d.linear_end() - 1) == &d.back());
+   REQUIRE(&d.linear_end()[-1] == &d.back());
+   REQUIRE(d.linear_begin() < d.linear_cend());
+   REQUIRE(d.linear_cbegin() == d.linear_begin());
+
+   std::reverse(d.linear_begin(), d.linear_end());
+   REQUIRE(std::is_sorted(d.crbegin(), d.crend()));
+   std::sort(d.linear_begin(), d.linear_end());
+   REQUIRE(std::is_sorted(d.cbegin(), d.cend()));
+   REQUIRE(d.front() == 0);
+}
+
+TEST_CASE("deque_linear_iterator - STL algorithms over wrapped values")
+{
+   check_linear_iterator<8>();
+   check_linear_iterator<11>();
+}
+
 }
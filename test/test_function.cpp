@@ -7,6 +7,7 @@ as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
 
 #include <catch.hpp>
 #include <utility>
+#include <type_traits>
 #include <memory>
 #include <functional>
 #include <sstl/function.h>
@@ -570,6 +571,76 @@ TEST_CASE("function - number of constructions of argument")
    }
 }
 
+TEST_CASE("function - small trivially copyable parameters")
+{
+   struct pair_type
+   {
+      int* first;
+      int* second;
+   };
+
+   int a = 1;
+   int b = 2;
+   auto f = sstl::function<int(pair_type, int, double), 0>{ [](pair_type pair, int i, double d)
+   {
+      return *pair.first + *pair.second + i + static_cast<int>(d);
+   }};
+   REQUIRE(f(pair_type{ &a, &b }, 3, 4.0) == 10);
+}
+
+TEST_CASE("function - conversion to compatible signature with by-value parameters")
+{
+   //the parameter of the source signature is forwarded by value, the one of the converted signature by reference
+   struct small_type
+   {
+      long a;
+      long b;
+   };
+   struct large_type : small_type
+   {
+      long c;
+      long d;
+   };
+
+   auto rhs = sstl::function<long(small_type), 0>{ [](small_type x){ return x.a + x.b; } };
+   auto arg = large_type{};
+   arg.a = 1; arg.b = 2; arg.c = 100; arg.d = 200;
+
+   SECTION("construction")
+   {
+      auto lhs = sstl::function<long(large_type), 64>{ rhs };
+      REQUIRE(lhs(arg) == 3);
+   }
+   SECTION("construction from base class reference")
+   {
+      const sstl::function<long(small_type)>& ref = rhs;
+      auto lhs = sstl::function<long(large_type), 64>{ ref };
+      REQUIRE(lhs(arg) == 3);
+   }
+   SECTION("assignment")
+   {
+      auto lhs = sstl::function<long(large_type), 64>{};
+      lhs = rhs;
+      REQUIRE(lhs(arg) == 3);
+   }
+   SECTION("copy of the converted function")
+   {
+      auto lhs = sstl::function<long(large_type), 64>{ rhs };
+      auto copy = lhs;
+      REQUIRE(copy(arg) == 3);
+   }
+   SECTION("converted return value and parameters")
+   {
+      auto lhs = sstl::function<double(int, int), 64>{ sstl::function<long(long, long), 0>{ [](long x, long y){ return x + y; } } };
+      REQUIRE(lhs(1, 2) == 3.0);
+   }
+   SECTION("invalid rhs")
+   {
+      auto lhs = sstl::function<long(large_type), 64>{ sstl::function<long(small_type), 0>{} };
+      REQUIRE(static_cast<bool>(lhs) == false);
+   }
+}
+
 TEST_CASE("function - constness")
 {
    struct nonconst_call_operator_type
@@ -594,11 +665,67 @@ TEST_CASE("function - constness")
    }
 }
 
+TEST_CASE("function - move-only trivially copyable target isn't copied with memcpy")
+{
+   struct move_only_type
+   {
+      move_only_type() = default;
+      move_only_type(const move_only_type&) = delete;
+      move_only_type(move_only_type&&) = default;
+      void operator()() const {}
+   };
+   REQUIRE(std::is_trivially_copyable<move_only_type>::value);
+   REQUIRE(!sstl::_detail::_is_trivial_function_target<move_only_type>::value);
+}
+
+TEST_CASE("function - trivially copyable target")
+{
+   int value = 0;
+   int increment = 2;
+   auto target = [&value, &increment](){ value += increment; };
+   using target_type = decltype(target);
+   REQUIRE(std::is_trivially_copyable<target_type>::value);
+
+   auto f = sstl::function<void(), sizeof(target_type)>{ target };
+   SECTION("copy construction")
+   {
+      auto copy = f;
+      copy();
+      REQUIRE(value == 2);
+   }
+   SECTION("move construction")
+   {
+      auto moved = std::move(f);
+      moved();
+      REQUIRE(value == 2);
+   }
+   SECTION("copy assignment")
+   {
+      auto copy = sstl::function<void(), sizeof(target_type)>{};
+      copy = f;
+      copy();
+      REQUIRE(value == 2);
+   }
+   SECTION("construction from function with larger buffer")
+   {
+      auto larger = sstl::function<void(), 2*sizeof(target_type)>{ target };
+      const sstl::function<void()>& ref = larger;
+      auto copy = sstl::function<void(), sizeof(target_type)>{ ref };
+      copy();
+      REQUIRE(value == 2);
+   }
+   SECTION("assignment of an invalid function")
+   {
+      f = sstl::function<void(), sizeof(target_type)>{};
+      REQUIRE(static_cast<bool>(f) == false);
+   }
+}
+
 TEST_CASE("function - size (let's keep it under control)")
 {
    static const size_t WORD_SIZE = sizeof(void*);
    using function_type = sstl::function<void(), 0>;
-   REQUIRE(sizeof(function_type) == 2*WORD_SIZE);
+   REQUIRE(sizeof(function_type) == 4*WORD_SIZE);
 }
 
 }
@@ -0,0 +1,122 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <catch.hpp>
+#include <type_traits>
+#include <sstl/function_ref.h>
+
+#include "counted_type.h"
+
+namespace sstl_test
+{
+
+static int add_one(int i) { return i + 1; }
+
+static int sum_of_visited_values(sstl::function_ref<int(int)> visitor)
+{
+   int sum = 0;
+   for(int i=0; i<3; ++i)
+      sum += visitor(i);
+   return sum;
+}
+
+TEST_CASE("function_ref - size")
+{
+   REQUIRE(sizeof(sstl::function_ref<void()>) == 2*sizeof(void*));
+   REQUIRE(std::is_trivially_copyable<sstl::function_ref<void()>>::value);
+}
+
+TEST_CASE("function_ref - construction")
+{
+   SECTION("from function")
+   {
+      REQUIRE(sum_of_visited_values(add_one) == 6);
+   }
+   SECTION("from function pointer")
+   {
+      auto pointer = &add_one;
+      REQUIRE(sum_of_visited_values(pointer) == 6);
+   }
+   SECTION("from closure")
+   {
+      int increment = 2;
+      REQUIRE(sum_of_visited_values([&increment](int i){ return i + increment; }) == 9);
+   }
+   SECTION("from mutable closure")
+   {
+      int calls = 0;
+      auto closure = [calls](int) mutable { return ++calls; };
+      REQUIRE(sum_of_visited_values(closure) == 6);
+   }
+   SECTION("from sstl::function")
+   {
+      auto f = sstl::function<int(int), sizeof(&add_one)>{ add_one };
+      REQUIRE(sum_of_visited_values(f) == 6);
+   }
+   SECTION("from sstl::function base class reference")
+   {
+      auto f = sstl::function<int(int), sizeof(&add_one)>{ add_one };
+      const sstl::function<int(int)>& ref = f;
+      REQUIRE(sum_of_visited_values(ref) == 6);
+   }
+   SECTION("from sstl::function with compatible signature")
+   {
+      auto f = sstl::function<long(long), 0>{ [](long i){ return i * 2; } };
+      REQUIRE(sum_of_visited_values(f) == 6);
+   }
+   SECTION("copy")
+   {
+      int increment = 2;
+      auto closure = [&increment](int i){ return i + increment; };
+      auto ref = sstl::function_ref<int(int)>{ closure };
+      auto copy = ref;
+      REQUIRE(copy(1) == 3);
+   }
+}
+
+TEST_CASE("function_ref - the callable is referenced")
+{
+   SECTION("no copies of the callable")
+   {
+      auto callable = counted_type{};
+      counted_type::reset_counts();
+      auto ref = sstl::function_ref<void()>{ callable };
+      ref();
+      REQUIRE(counted_type::check().constructions(0));
+   }
+   SECTION("state of the callable")
+   {
+      int calls = 0;
+      auto closure = [calls]() mutable { return ++calls; };
+      auto ref = sstl::function_ref<int()>{ closure };
+      ref();
+      REQUIRE(ref() == 2);
+      REQUIRE(closure() == 3);
+   }
+}
+
+TEST_CASE("function_ref - parameters and return value")
+{
+   SECTION("reference parameter and return value")
+   {
+      auto closure = [](int& i) -> int& { return i; };
+      auto ref = sstl::function_ref<int&(int&)>{ closure };
+      int i;
+      REQUIRE(&ref(i) == &i);
+   }
+   SECTION("by-value parameter generates one copy construction")
+   {
+      auto closure = [](counted_type){};
+      auto ref = sstl::function_ref<void(counted_type)>{ closure };
+      auto c = counted_type{};
+      counted_type::reset_counts();
+      ref(c);
+      REQUIRE(counted_type::check().copy_constructions(1));
+   }
+}
+
+}
@@ -0,0 +1,157 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <catch.hpp>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include <thread>
+#include <sstl/mpmc_queue.h>
+
+#include "utility.h"
+#include "counted_type.h"
+
+namespace sstl_test
+{
+
+//the queue requires a nothrow move constructible value type
+class nothrow_movable_counted_type : public counted_type
+{
+public:
+   using counted_type::counted_type;
+   nothrow_movable_counted_type() = default;
+   nothrow_movable_counted_type(const nothrow_movable_counted_type&) = default;
+   nothrow_movable_counted_type(nothrow_movable_counted_type&& rhs) noexcept : counted_type(std::move(rhs)) {}
+   nothrow_movable_counted_type& operator=(const nothrow_movable_counted_type&) = default;
+   nothrow_movable_counted_type& operator=(nothrow_movable_counted_type&&) = default;
+};
+
+TEST_CASE("mpmc_queue - push and pop")
+{
+   sstl::mpmc_queue<int, 3> q;
+   REQUIRE(q.empty());
+   REQUIRE(q.capacity() == 3);
+
+   int value = 0;
+   REQUIRE(!q.try_pop(value));
+   for(int i=0; i<10; ++i)
+   {
+      REQUIRE(q.try_push(i));
+      q.push(i+1);
+      REQUIRE(q.size() == 2);
+      REQUIRE(q.try_pop(value));
+      REQUIRE(value == i);
+      q.pop(value);
+      REQUIRE(value == i+1);
+   }
+
+   REQUIRE(q.try_emplace(0));
+   REQUIRE(q.try_emplace(1));
+   REQUIRE(q.try_emplace(2));
+   REQUIRE(!q.try_emplace(3));
+   REQUIRE(q.size() == 3);
+}
+
+TEST_CASE("mpmc_queue - the slots are aligned to the cache line size")
+{
+   REQUIRE(std::alignment_of<sstl::mpmc_queue<char, 3>>::value == sstl::_cache_line_size);
+   sstl::mpmc_queue<char, 3> q;
+   REQUIRE(reinterpret_cast<std::uintptr_t>(&q) % sstl::_cache_line_size == 0);
+}
+
+TEST_CASE("mpmc_queue - elements' lifetime")
+{
+   SECTION("pop")
+   {
+      sstl::mpmc_queue<nothrow_movable_counted_type, 3> q;
+      counted_type::reset_counts();
+      q.try_emplace(0);
+      auto value = nothrow_movable_counted_type{};
+      q.try_pop(value);
+      REQUIRE(value.member == 0);
+      REQUIRE(counted_type::check().parameter_constructions(1).default_constructions(1)
+                                   .move_constructions(2).move_assignments(1).destructions(3));
+   }
+   SECTION("destruction")
+   {
+      {
+         sstl::mpmc_queue<nothrow_movable_counted_type, 3> q;
+         q.push(nothrow_movable_counted_type{ 0 });
+         q.emplace(1);
+         counted_type::reset_counts();
+      }
+      REQUIRE(counted_type::check().destructions(2));
+   }
+   #if _sstl_has_exceptions()
+   SECTION("exception handling")
+   {
+      sstl::mpmc_queue<nothrow_movable_counted_type, 3> q;
+      auto value = nothrow_movable_counted_type{ 0 };
+      counted_type::reset_counts();
+      counted_type::throw_at_nth_copy_construction(1);
+      REQUIRE_THROWS_AS(q.try_push(value), counted_type::copy_construction::exception);
+      REQUIRE(q.empty());
+      REQUIRE(q.try_push(value));
+      REQUIRE(q.size() == 1);
+   }
+   #endif
+}
+
+TEST_CASE("mpmc_queue - concurrent producers and consumers")
+{
+   static const int threads = 4;
+   static const int count_per_producer = 20000;
+   sstl::mpmc_queue<int, 64> q;
+
+   auto producers = std::vector<std::thread>{};
+   for(int t=0; t<threads; ++t)
+   {
+      producers.emplace_back([&q, t]()
+      {
+         for(int i=0; i<count_per_producer; ++i)
+            q.push(t*count_per_producer + i);
+      });
+   }
+
+   auto popped = std::vector<std::vector<int>>(threads);
+   auto consumers = std::vector<std::thread>{};
+   for(int t=0; t<threads; ++t)
+   {
+      consumers.emplace_back([&q, &popped, t]()
+      {
+         int value;
+         for(int i=0; i<count_per_producer; ++i)
+         {
+            q.pop(value);
+            popped[t].push_back(value);
+         }
+      });
+   }
+
+   for(auto& thread : producers)
+      thread.join();
+   for(auto& thread : consumers)
+      thread.join();
+
+   //every value is popped exactly once and, per consumer, the values of a producer are in order
+   auto is_popped = std::vector<bool>(threads*count_per_producer, false);
+   auto is_consistent = true;
+   for(const auto& values : popped)
+   {
+      auto last_of_producer = std::vector<int>(threads, -1);
+      for(auto value : values)
+      {
+         is_consistent = is_consistent && !is_popped[value] && value > last_of_producer[value/count_per_producer];
+         is_popped[value] = true;
+         last_of_producer[value/count_per_producer] = value;
+      }
+   }
+   REQUIRE(is_consistent);
+   REQUIRE(q.empty());
+}
+
+}
@@ -0,0 +1,145 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <catch.hpp>
+#include <vector>
+#include <thread>
+#include <sstl/spsc_queue.h>
+
+#include "utility.h"
+#include "counted_type.h"
+
+namespace sstl_test
+{
+
+TEST_CASE("spsc_queue - push and pop")
+{
+   sstl::spsc_queue<int, 3> q;
+   REQUIRE(q.empty());
+   REQUIRE(q.capacity() == 3);
+
+   int value = 0;
+   REQUIRE(!q.try_pop(value));
+   for(int i=0; i<10; ++i)
+   {
+      REQUIRE(q.try_push(i));
+      REQUIRE(q.try_emplace(i+1));
+      REQUIRE(q.size() == 2);
+      REQUIRE(q.try_pop(value));
+      REQUIRE(value == i);
+      REQUIRE(q.try_pop(value));
+      REQUIRE(value == i+1);
+   }
+
+   REQUIRE(q.try_push(0));
+   REQUIRE(q.try_push(1));
+   REQUIRE(q.try_push(2));
+   REQUIRE(!q.try_push(3));
+   REQUIRE(q.size() == 3);
+}
+
+TEST_CASE("spsc_queue - batch push and pop")
+{
+   sstl::spsc_queue<int, 5> q;
+   auto values = std::vector<int>{0, 1, 2, 3, 4, 5, 6};
+   auto popped = std::vector<int>(7);
+
+   REQUIRE(q.try_push_n(values.cbegin(), 3) == 3);
+   REQUIRE(q.try_pop_n(popped.begin(), 2) == 2);
+   REQUIRE(q.try_push_n(values.cbegin()+3, 4) == 4);
+   REQUIRE(q.try_push_n(values.cbegin(), 1) == 0);
+   REQUIRE(q.try_pop_n(popped.begin()+2, 7) == 5);
+   REQUIRE(popped == values);
+   REQUIRE(q.try_pop_n(popped.begin(), 1) == 0);
+}
+
+TEST_CASE("spsc_queue - elements' lifetime")
+{
+   SECTION("pop")
+   {
+      sstl::spsc_queue<counted_type, 3> q;
+      counted_type::reset_counts();
+      q.try_push(counted_type{ 0 });
+      q.try_emplace(1);
+      auto value = counted_type{};
+      q.try_pop(value);
+      REQUIRE(value.member == 0);
+      REQUIRE(counted_type::check().parameter_constructions(2).default_constructions(1).move_constructions(1)
+                                   .move_assignments(1).destructions(2));
+   }
+   SECTION("destruction")
+   {
+      {
+         sstl::spsc_queue<counted_type, 3> q;
+         q.try_emplace(0);
+         q.try_emplace(1);
+         counted_type::reset_counts();
+      }
+      REQUIRE(counted_type::check().destructions(2));
+   }
+   #if _sstl_has_exceptions()
+   SECTION("exception handling")
+   {
+      sstl::spsc_queue<counted_type, 5> q;
+      auto values = std::vector<counted_type>{0, 1, 2, 3};
+      counted_type::reset_counts();
+      counted_type::throw_at_nth_copy_construction(3);
+      REQUIRE_THROWS_AS(q.try_push_n(values.cbegin(), values.size()), counted_type::copy_construction::exception);
+      REQUIRE(counted_type::check().copy_constructions(2).destructions(2));
+      REQUIRE(q.empty());
+   }
+   #endif
+}
+
+TEST_CASE("spsc_queue - concurrent producer and consumer")
+{
+   static const int count = 100000;
+   sstl::spsc_queue<int, 64> q;
+
+   auto producer = std::thread([&q]()
+   {
+      int batch[4];
+      for(int i=0; i<count; )
+      {
+         size_t pushed = 0;
+         if(i % 2 == 0)
+         {
+            pushed = q.try_push(i) ? 1 : 0;
+         }
+         else
+         {
+            auto batch_size = std::min(4, count-i);
+            for(int j=0; j<batch_size; ++j)
+               batch[j] = i+j;
+            pushed = q.try_push_n(batch, batch_size);
+         }
+         if(pushed == 0)
+            std::this_thread::yield();
+         i += static_cast<int>(pushed);
+      }
+   });
+
+   auto popped = std::vector<int>{};
+   popped.reserve(count);
+   int batch[8];
+   while(popped.size() < static_cast<size_t>(count))
+   {
+      auto n = q.try_pop_n(batch, 8);
+      if(n == 0)
+         std::this_thread::yield();
+      popped.insert(popped.end(), batch, batch+n);
+   }
+   producer.join();
+
+   auto is_sequence = true;
+   for(int i=0; i<count; ++i)
+      is_sequence = is_sequence && popped[i] == i;
+   REQUIRE(is_sequence);
+   REQUIRE(q.empty());
+}
+
+}
@@ -0,0 +1,125 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <catch.hpp>
+
+#include <sstl/vector.h>
+#include <sstl/deque.h>
+#include <sstl/bitmap_allocator.h>
+#include <sstl/freelist_allocator.h>
+
+namespace sstl_test
+{
+
+#if _sstl_has_stats()
+
+TEST_CASE("stats - vector")
+{
+   SECTION("construction")
+   {
+      auto v = sstl::vector<int, 11>(5, 0);
+      REQUIRE(v.stats().high_water_mark == 5);
+      REQUIRE(v.stats().operations == 1);
+      REQUIRE(v.stats().insertions == 5);
+      REQUIRE(v.stats().erasures == 0);
+   }
+   SECTION("insertions and erasures")
+   {
+      auto v = sstl::vector<int, 11>{};
+      v.push_back(0);
+      v.push_back(1);
+      v.insert(v.begin(), 3, 2);
+      v.erase(v.begin(), v.begin()+2);
+      v.pop_back();
+      REQUIRE(v.stats().high_water_mark == 5);
+      REQUIRE(v.stats().operations == 5);
+      REQUIRE(v.stats().insertions == 5);
+      REQUIRE(v.stats().erasures == 3);
+   }
+   SECTION("assignment")
+   {
+      auto v = sstl::vector<int, 11>{ 0, 1, 2 };
+      v = { 0 };
+      REQUIRE(v.stats().high_water_mark == 3);
+      REQUIRE(v.stats().operations == 2);
+      REQUIRE(v.stats().insertions == 3);
+      REQUIRE(v.stats().erasures == 2);
+   }
+   SECTION("move assignment records the moved-from instance too")
+   {
+      auto lhs = sstl::vector<int, 11>{};
+      auto rhs = sstl::vector<int, 11>{ 0, 1, 2 };
+      lhs = std::move(rhs);
+      REQUIRE(lhs.stats().insertions == 3);
+      REQUIRE(rhs.stats().erasures == 3);
+   }
+   SECTION("reset")
+   {
+      auto v = sstl::vector<int, 11>{ 0, 1, 2 };
+      v.pop_back();
+      v.reset_stats();
+      REQUIRE(v.stats().high_water_mark == 2);
+      REQUIRE(v.stats().operations == 0);
+      REQUIRE(v.stats().insertions == 0);
+      REQUIRE(v.stats().erasures == 0);
+   }
+}
+
+TEST_CASE("stats - deque")
+{
+   SECTION("insertions and erasures")
+   {
+      auto d = sstl::deque<int, 11>{};
+      d.push_back(0);
+      d.push_front(1);
+      d.insert(d.begin()+1, 3, 2);
+      d.pop_front();
+      d.pop_back();
+      d.erase(d.begin());
+      REQUIRE(d.stats().high_water_mark == 5);
+      REQUIRE(d.stats().operations == 6);
+      REQUIRE(d.stats().insertions == 5);
+      REQUIRE(d.stats().erasures == 3);
+   }
+   SECTION("operations implemented in terms of other operations are recorded once")
+   {
+      auto lhs = sstl::deque<int, 11>{ 0 };
+      auto rhs = sstl::deque<int, 11>{ 0, 1, 2 };
+      lhs.swap(rhs);
+      REQUIRE(lhs.stats().operations == 2);
+      REQUIRE(lhs.stats().high_water_mark == 3);
+      REQUIRE(lhs.stats().insertions == 1 + 2);
+      REQUIRE(rhs.stats().operations == 2);
+      REQUIRE(rhs.stats().erasures == 2);
+   }
+}
+
+template<class TAllocator>
+void check_allocator_stats()
+{
+   auto allocator = TAllocator{};
+   auto p0 = allocator.allocate();
+   auto p1 = allocator.allocate();
+   allocator.deallocate(p0);
+   auto p2 = allocator.allocate();
+   allocator.deallocate(p1);
+   allocator.deallocate(p2);
+   REQUIRE(allocator.stats().allocated_blocks == 0);
+   REQUIRE(allocator.stats().high_water_mark == 2);
+   REQUIRE(allocator.stats().allocations == 3);
+   REQUIRE(allocator.stats().deallocations == 3);
+}
+
+TEST_CASE("stats - allocators")
+{
+   check_allocator_stats<sstl::bitmap_allocator<int, 11>>();
+   check_allocator_stats<sstl::freelist_allocator<int, 11>>();
+}
+
+#endif
+
+}
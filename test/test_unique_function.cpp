@@ -0,0 +1,223 @@
+/*
+Copyright © 2015 Kean Mariotti <kean.mariotti@gmail.com>
+This work is free. You can redistribute it and/or modify it under the
+terms of the Do What The Fuck You Want To Public License, Version 2,
+as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
+*/
+
+#include <catch.hpp>
+#include <type_traits>
+#include <utility>
+#include <memory>
+#include <sstl/unique_function.h>
+#include <sstl/__internal/_except.h>
+
+#include "counted_type.h"
+
+namespace sstl_test
+{
+
+//function object that owns a unique resource
+struct unique_resource_callable
+{
+   int operator()(int i) const { return *resource + i; }
+   std::unique_ptr<int> resource;
+};
+
+static unique_resource_callable make_unique_resource_callable(int value)
+{
+   return unique_resource_callable{ std::unique_ptr<int>(new int(value)) };
+}
+
+struct member_type
+{
+   int add(int i) { return i + 1; }
+};
+
+TEST_CASE("unique_function - move-only")
+{
+   using function_type = sstl::unique_function<int(int), sizeof(unique_resource_callable)>;
+   REQUIRE(!std::is_copy_constructible<function_type>::value);
+   REQUIRE(!std::is_copy_assignable<function_type>::value);
+   REQUIRE(std::is_move_constructible<function_type>::value);
+   REQUIRE(std::is_move_assignable<function_type>::value);
+   REQUIRE(!std::is_default_constructible<sstl::unique_function<int(int)>>::value);
+   REQUIRE(!std::is_destructible<sstl::unique_function<int(int)>>::value);
+}
+
+TEST_CASE("unique_function - construction")
+{
+   SECTION("default")
+   {
+      auto f = sstl::unique_function<int(int), 0>{};
+      REQUIRE(static_cast<bool>(f) == false);
+   }
+   SECTION("move-only target")
+   {
+      auto f = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{ make_unique_resource_callable(1) };
+      REQUIRE(static_cast<bool>(f) == true);
+      REQUIRE(f(2) == 3);
+   }
+   SECTION("closure")
+   {
+      int value = 1;
+      auto f = sstl::unique_function<int(int), sizeof(int*)>{ [&value](int i){ return value + i; } };
+      REQUIRE(f(2) == 3);
+   }
+   SECTION("pointer to member function")
+   {
+      auto f = sstl::unique_function<int(member_type&, int), sizeof(&member_type::add)>{ &member_type::add };
+      member_type m;
+      REQUIRE(f(m, 2) == 3);
+   }
+   SECTION("number of target's constructions")
+   {
+      auto target = counted_type{};
+      counted_type::reset_counts();
+      SECTION("target is lvalue")
+      {
+         sstl::unique_function<void(), sizeof(counted_type)>{ target };
+         REQUIRE(counted_type::check().copy_constructions(1));
+      }
+      SECTION("target is rvalue")
+      {
+         sstl::unique_function<void(), sizeof(counted_type)>{ std::move(target) };
+         REQUIRE(counted_type::check().move_constructions(1));
+      }
+   }
+}
+
+TEST_CASE("unique_function - move construction")
+{
+   SECTION("rhs is invalid")
+   {
+      auto rhs = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{};
+      auto lhs = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{ std::move(rhs) };
+      REQUIRE(static_cast<bool>(lhs) == false);
+   }
+   SECTION("rhs is valid")
+   {
+      auto rhs = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{ make_unique_resource_callable(1) };
+      auto lhs = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{ std::move(rhs) };
+      REQUIRE(static_cast<bool>(rhs) == false);
+      REQUIRE(lhs(2) == 3);
+   }
+   SECTION("rhs is base class reference")
+   {
+      auto rhs = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{ make_unique_resource_callable(1) };
+      sstl::unique_function<int(int)>& ref = rhs;
+      auto lhs = sstl::unique_function<int(int), 2*sizeof(unique_resource_callable)>{ std::move(ref) };
+      REQUIRE(static_cast<bool>(rhs) == false);
+      REQUIRE(lhs(2) == 3);
+   }
+   SECTION("trivially copyable target")
+   {
+      int value = 1;
+      auto rhs = sstl::unique_function<int(int), sizeof(int*)>{ [&value](int i){ return value + i; } };
+      auto lhs = sstl::unique_function<int(int), sizeof(int*)>{ std::move(rhs) };
+      REQUIRE(static_cast<bool>(rhs) == false);
+      REQUIRE(lhs(2) == 3);
+   }
+   SECTION("number of target's constructions and destructions")
+   {
+      auto rhs = sstl::unique_function<void(), sizeof(counted_type)>{ counted_type{} };
+      counted_type::reset_counts();
+      auto lhs = sstl::unique_function<void(), sizeof(counted_type)>{ std::move(rhs) };
+      REQUIRE(counted_type::check().move_constructions(1).destructions(1));
+   }
+}
+
+TEST_CASE("unique_function - move assignment")
+{
+   SECTION("lhs is invalid and rhs is valid")
+   {
+      auto rhs = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{ make_unique_resource_callable(1) };
+      auto lhs = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{};
+      lhs = std::move(rhs);
+      REQUIRE(static_cast<bool>(rhs) == false);
+      REQUIRE(lhs(2) == 3);
+   }
+   SECTION("lhs is valid and rhs is invalid")
+   {
+      auto rhs = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{};
+      auto lhs = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{ make_unique_resource_callable(1) };
+      lhs = std::move(rhs);
+      REQUIRE(static_cast<bool>(lhs) == false);
+   }
+   SECTION("rhs is base class reference")
+   {
+      auto rhs = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{ make_unique_resource_callable(1) };
+      auto lhs = sstl::unique_function<int(int), 2*sizeof(unique_resource_callable)>{ make_unique_resource_callable(0) };
+      sstl::unique_function<int(int)>& ref = rhs;
+      lhs = std::move(ref);
+      REQUIRE(static_cast<bool>(rhs) == false);
+      REQUIRE(lhs(2) == 3);
+   }
+   SECTION("lhs is base class reference")
+   {
+      auto rhs = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{ make_unique_resource_callable(1) };
+      auto lhs = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{};
+      sstl::unique_function<int(int)>& ref = lhs;
+      ref = std::move(rhs);
+      REQUIRE(lhs(2) == 3);
+   }
+   SECTION("number of target's constructions and destructions")
+   {
+      auto rhs = sstl::unique_function<void(), sizeof(counted_type)>{ counted_type{} };
+      auto lhs = sstl::unique_function<void(), sizeof(counted_type)>{ counted_type{} };
+      counted_type::reset_counts();
+      lhs = std::move(rhs);
+      REQUIRE(counted_type::check().move_constructions(1).destructions(2));
+   }
+   #if _sstl_has_exceptions()
+   SECTION("exception handling")
+   {
+      auto rhs = sstl::unique_function<void(), sizeof(counted_type)>{ counted_type{} };
+      auto lhs = sstl::unique_function<void(), sizeof(counted_type)>{ counted_type{} };
+      counted_type::reset_counts();
+      counted_type::throw_at_nth_move_construction(1);
+      REQUIRE_THROWS_AS(lhs = std::move(rhs), counted_type::move_construction::exception);
+      REQUIRE(static_cast<bool>(lhs) == false);
+      REQUIRE(static_cast<bool>(rhs) == true);
+   }
+   #endif
+}
+
+TEST_CASE("unique_function - template assignment")
+{
+   SECTION("move-only target")
+   {
+      auto f = sstl::unique_function<int(int), sizeof(unique_resource_callable)>{};
+      f = make_unique_resource_callable(1);
+      REQUIRE(f(2) == 3);
+   }
+   SECTION("target replaces previous target")
+   {
+      auto f = sstl::unique_function<void(), sizeof(counted_type)>{ counted_type{} };
+      counted_type::reset_counts();
+      f = counted_type{};
+      REQUIRE(counted_type::check().default_constructions(1).move_constructions(1).destructions(2));
+   }
+   #if _sstl_has_exceptions()
+   SECTION("exception handling")
+   {
+      auto target = counted_type{};
+      auto f = sstl::unique_function<void(), sizeof(counted_type)>{ [](){} };
+      counted_type::reset_counts();
+      counted_type::throw_at_nth_copy_construction(1);
+      REQUIRE_THROWS_AS(f = target, counted_type::copy_construction::exception);
+      REQUIRE(static_cast<bool>(f) == false);
+   }
+   #endif
+}
+
+TEST_CASE("unique_function - destructor")
+{
+   {
+      auto f = sstl::unique_function<void(), sizeof(counted_type)>{ counted_type{} };
+      counted_type::reset_counts();
+   }
+   REQUIRE(counted_type::check().destructions(1));
+}
+
+}
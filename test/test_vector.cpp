@@ -7,6 +7,10 @@ as published by Sam Hocevar. See http://www.wtfpl.net/ for more details.
 
 #include <catch.hpp>
 #include <type_traits>
+#include <vector>
+#include <forward_list>
+#include <numeric>
+#include <cstring>
 #include <sstl/__internal/_preprocessor.h>
 #include <sstl/__internal/_except.h>
 #include <sstl/vector.h>
@@ -743,6 +747,23 @@ TEST_CASE("vector - max size / capacity")
    }
 }
 
+TEST_CASE("vector - sized and capacity-agnostic accessors are equivalent")
+{
+   auto v = vector_int_t{1, 3, 7};
+   const auto& sized = v;
+   const vector_int_base_t& base = v;
+   REQUIRE(sized.begin() == base.begin());
+   REQUIRE(sized.end() == base.end());
+   REQUIRE(sized.data() == base.data());
+   REQUIRE(&sized.front() == &base.front());
+   REQUIRE(&sized.back() == &base.back());
+   REQUIRE(&sized[1] == &base[1]);
+   REQUIRE(sized.size() == base.size());
+   REQUIRE(sized.empty() == base.empty());
+   REQUIRE(sized.capacity() == base.capacity());
+   REQUIRE(sized.max_size() == base.max_size());
+}
+
 TEST_CASE("vector - clear")
 {
    SECTION("contained values")
@@ -1445,6 +1466,15 @@ TEST_CASE("vector - insert (input iterators + forward iterators + initializer-li
          }
       }
    }
+   SECTION("range (forward iterator, not bidirectional)")
+   {
+      auto values = std::forward_list<counted_type>{ 7, 11 };
+      counted_type::reset_counts();
+      auto pos = v.insert(v.begin()+1, values.begin(), values.end());
+      REQUIRE(counted_type::check().move_constructions(2).move_assignments(2).copy_assignments(2));
+      REQUIRE(pos == v.begin()+1);
+      REQUIRE(are_containers_equal(v, std::initializer_list<counted_type>{3, 7, 11, 3, 3, 3, 3}));
+   }
    #if _sstl_has_exceptions()
    SECTION("exception handling")
    {
@@ -1919,6 +1949,67 @@ TEST_CASE("vector - pop_back")
    }
 }
 
+TEST_CASE("vector - resize_default_init")
+{
+   SECTION("grow")
+   {
+      auto v = vector_counted_type_t{1, 3};
+      counted_type::reset_counts();
+      v.resize_default_init(5);
+      REQUIRE(counted_type::check().default_constructions(3).destructions(0));
+      REQUIRE(v == (vector_counted_type_t{1, 3, counted_type(), counted_type(), counted_type()}));
+   }
+   SECTION("shrink")
+   {
+      auto v = vector_counted_type_t{1, 3, 5};
+      counted_type::reset_counts();
+      v.resize_default_init(1);
+      REQUIRE(counted_type::check().constructions(0).destructions(2));
+      REQUIRE(v == (vector_counted_type_t{1}));
+   }
+   #if _sstl_has_exceptions()
+   SECTION("exception safety")
+   {
+      auto v = vector_counted_type_t{1, 3};
+      counted_type::reset_counts();
+      counted_type::throw_at_nth_default_construction(3);
+      REQUIRE_THROWS_AS(v.resize_default_init(5), counted_type::default_construction::exception);
+      REQUIRE(counted_type::check().default_constructions(2).destructions(2));
+      REQUIRE(v == (vector_counted_type_t{1, 3}));
+   }
+   #endif
+   SECTION("trivial value type")
+   {
+      auto v = sstl::vector<unsigned char, 11>{ 1, 3 };
+      v.resize_default_init(4);
+      std::memcpy(v.data()+2, "\x05\x07", 2);
+      REQUIRE(are_containers_equal(v, std::initializer_list<unsigned char>{1, 3, 5, 7}));
+   }
+}
+
+TEST_CASE("vector - append_uninitialized + commit")
+{
+   SECTION("trivial value type")
+   {
+      auto v = sstl::vector<unsigned char, 11>{ 1 };
+      auto tail = v.append_uninitialized(10);
+      REQUIRE(tail == v.data()+1);
+      REQUIRE(v.size() == 1);
+      std::memcpy(tail, "\x03\x05\x07", 3);
+      v.commit(3);
+      REQUIRE(are_containers_equal(v, std::initializer_list<unsigned char>{1, 3, 5, 7}));
+   }
+   SECTION("non-trivial value type")
+   {
+      auto v = vector_counted_type_t{1};
+      auto tail = v.append_uninitialized(2);
+      new(tail) counted_type(3);
+      new(tail+1) counted_type(5);
+      v.commit(2);
+      REQUIRE(v == (vector_counted_type_t{1, 3, 5}));
+   }
+}
+
 TEST_CASE("vector - swap")
 {
    SECTION("contained values")
@@ -2043,11 +2134,162 @@ TEST_CASE("vector - non-member relative operators")
    }
 }
 
+TEST_CASE("vector - trivially copyable value type (bulk copies)")
+{
+   SECTION("range constructor")
+   {
+      auto values = std::initializer_list<int>{1, 3, 7};
+      auto v = vector_int_t(values.begin(), values.end());
+      REQUIRE(are_containers_equal(v, values));
+   }
+   SECTION("copy constructor")
+   {
+      auto rhs = vector_int_t{1, 3, 7};
+      auto lhs = vector_int_t(rhs);
+      REQUIRE(are_containers_equal(lhs, rhs));
+   }
+   SECTION("move constructor")
+   {
+      auto rhs = vector_int_t{1, 3, 7};
+      auto lhs = vector_int_t(std::move(rhs));
+      REQUIRE(are_containers_equal(lhs, std::initializer_list<int>{1, 3, 7}));
+      REQUIRE(rhs.empty());
+   }
+   SECTION("copy assignment")
+   {
+      auto rhs = vector_int_t{1, 3, 7};
+      auto lhs = vector_int_t{11, 13, 17, 19};
+      lhs = rhs;
+      REQUIRE(are_containers_equal(lhs, rhs));
+   }
+   SECTION("move assignment")
+   {
+      auto rhs = vector_int_t{1, 3, 7, 11};
+      auto lhs = vector_int_t{13};
+      lhs = std::move(rhs);
+      REQUIRE(are_containers_equal(lhs, std::initializer_list<int>{1, 3, 7, 11}));
+      REQUIRE(rhs.empty());
+   }
+   SECTION("range assign (range belonging to the vector itself)")
+   {
+      auto v = vector_int_t{1, 3, 7, 11};
+      v.assign(v.begin()+1, v.end());
+      REQUIRE(are_containers_equal(v, std::initializer_list<int>{3, 7, 11}));
+   }
+   SECTION("range insert")
+   {
+      auto v = vector_int_t{1, 3, 7};
+      auto values = std::initializer_list<int>{11, 13};
+      auto pos = v.insert(v.begin()+1, values.begin(), values.end());
+      REQUIRE(pos == v.begin()+1);
+      REQUIRE(are_containers_equal(v, std::initializer_list<int>{1, 11, 13, 3, 7}));
+      pos = v.insert(v.end(), {17});
+      REQUIRE(pos == v.end()-1);
+      REQUIRE(are_containers_equal(v, std::initializer_list<int>{1, 11, 13, 3, 7, 17}));
+   }
+   SECTION("erase")
+   {
+      auto v = vector_int_t{1, 3, 7, 11, 13};
+      auto pos = v.erase(v.begin()+1);
+      REQUIRE(pos == v.begin()+1);
+      REQUIRE(are_containers_equal(v, std::initializer_list<int>{1, 7, 11, 13}));
+      pos = v.erase(v.begin()+1, v.begin()+3);
+      REQUIRE(pos == v.begin()+1);
+      REQUIRE(are_containers_equal(v, std::initializer_list<int>{1, 13}));
+      pos = v.erase(v.begin()+1);
+      REQUIRE(pos == v.end());
+      REQUIRE(are_containers_equal(v, std::initializer_list<int>{1}));
+   }
+   SECTION("swap")
+   {
+      auto large_values = std::vector<int>(100);
+      std::iota(large_values.begin(), large_values.end(), 0);
+      auto small_values = std::initializer_list<int>{ 1, 3, 7 };
+      auto lhs = sstl::vector<int, 100>(large_values.begin(), large_values.end());
+      auto rhs = sstl::vector<int, 100>(small_values);
+      lhs.swap(rhs);
+      REQUIRE(are_containers_equal(lhs, small_values));
+      REQUIRE(are_containers_equal(rhs, large_values));
+      rhs.swap(lhs);
+      REQUIRE(are_containers_equal(lhs, large_values));
+      REQUIRE(are_containers_equal(rhs, small_values));
+      lhs.swap(lhs);
+      REQUIRE(are_containers_equal(lhs, large_values));
+   }
+}
+
+TEST_CASE("vector - trivially relocatable value type (raw memory shifts)")
+{
+   using vector_relocatable_t = sstl::vector<relocatable_counted_type, 11>;
+   auto v = vector_relocatable_t{0, 1, 2, 3};
+   counted_type::reset_counts();
+
+   SECTION("insert (value)")
+   {
+      auto value = relocatable_counted_type{ 10 };
+      counted_type::reset_counts();
+      auto pos = v.insert(v.begin()+1, value);
+      REQUIRE(counted_type::check{}.copy_constructions(1).move_assignments(0).destructions(0));
+      REQUIRE(pos == v.begin()+1);
+      REQUIRE(v == (vector_relocatable_t{0, 10, 1, 2, 3}));
+   }
+   SECTION("insert (value belonging to the vector itself)")
+   {
+      v.insert(v.begin(), v[2]);
+      REQUIRE(v == (vector_relocatable_t{2, 0, 1, 2, 3}));
+   }
+   #if _sstl_has_exceptions()
+   SECTION("insert (value), exception safety")
+   {
+      auto value = relocatable_counted_type{ 10 };
+      counted_type::reset_counts();
+      counted_type::throw_at_nth_copy_construction(1);
+      REQUIRE_THROWS_AS(v.insert(v.begin()+1, value), counted_type::copy_construction::exception);
+      REQUIRE(counted_type::check{}.constructions(0).destructions(0));
+      REQUIRE(v == (vector_relocatable_t{0, 1, 2, 3}));
+   }
+   #endif
+   SECTION("insert (range)")
+   {
+      auto values = std::initializer_list<relocatable_counted_type>{10, 11};
+      counted_type::reset_counts();
+      auto pos = v.insert(v.begin()+1, values.begin(), values.end());
+      REQUIRE(counted_type::check{}.copy_constructions(2).move_assignments(0).destructions(0));
+      REQUIRE(pos == v.begin()+1);
+      REQUIRE(v == (vector_relocatable_t{0, 10, 11, 1, 2, 3}));
+   }
+   #if _sstl_has_exceptions()
+   SECTION("insert (range), exception safety")
+   {
+      auto values = std::initializer_list<relocatable_counted_type>{10, 11, 12};
+      counted_type::reset_counts();
+      counted_type::throw_at_nth_copy_construction(3);
+      REQUIRE_THROWS_AS(v.insert(v.begin()+1, values.begin(), values.end()), counted_type::copy_construction::exception);
+      REQUIRE(counted_type::check{}.copy_constructions(2).destructions(2));
+      REQUIRE(v == (vector_relocatable_t{0, 1, 2, 3}));
+   }
+   #endif
+   SECTION("erase")
+   {
+      auto pos = v.erase(v.begin()+1);
+      REQUIRE(counted_type::check{}.constructions(0).move_assignments(0).destructions(1));
+      REQUIRE(pos == v.begin()+1);
+      REQUIRE(v == (vector_relocatable_t{0, 2, 3}));
+      counted_type::reset_counts();
+      pos = v.erase(v.begin(), v.begin()+2);
+      REQUIRE(counted_type::check{}.constructions(0).move_assignments(0).destructions(2));
+      REQUIRE(pos == v.begin());
+      REQUIRE(v == (vector_relocatable_t{3}));
+   }
+}
+
+#if !_sstl_has_stats() //the statistics add member variables
 TEST_CASE("vector - memory footprint")
 {
    using word_size_t = void*;
    REQUIRE(sizeof(sstl::vector<word_size_t, 1>) == (1+1+1)*sizeof(word_size_t));
    REQUIRE(sizeof(sstl::vector<word_size_t, 10>) == (1+10+1)*sizeof(word_size_t));
 }
+#endif
 
 }